@@ -1,14 +1,16 @@
 
+#include <algorithm>
 #include <iostream>
 #include <cstring>
 #include <cctype>
 #include <string>
+#include <utility>
 #include "Mystring.h"
 
 // No-args constructor
 // Create empty string "" with a single null terminator
 Mystring::Mystring()
-    : str{nullptr} {
+    : str{nullptr}, capacity{0} {
     str = new char[1];
     *str = '\0';
 }
@@ -16,27 +18,34 @@ Mystring::Mystring()
 // Overloaded constructor
 // Initialize from C string argument; treat nullptr as empty
 Mystring::Mystring(const char *s)
-    : str{nullptr} {
+    : str{nullptr}, capacity{0} {
     if (s == nullptr) {
         str = new char[1];
         *str = '\0';
     } else {
-        str = new char[std::strlen(s) + 1];
+        capacity = std::strlen(s);
+        str = new char[capacity + 1];
         std::strcpy(str, s);
     }
 }
 
+// Adopting constructor (private): take ownership of a filled buffer
+Mystring::Mystring(char *buffer, std::size_t length, Adopt)
+    : str{buffer}, capacity{length} {
+}
+
 // Copy constructor (deep copy)
 Mystring::Mystring(const Mystring &source)
-    : str{nullptr} {
-    str = new char[std::strlen(source.str) + 1];
+    : str{nullptr}, capacity{std::strlen(source.str)} {
+    str = new char[capacity + 1];
     std::strcpy(str, source.str);
 }
 
 // Move constructor (steal pointer, null out source)
 Mystring::Mystring(Mystring &&source)
-    : str{source.str} {
+    : str{source.str}, capacity{source.capacity} {
     source.str = nullptr;
+    source.capacity = 0;
 }
 
 // Destructor
@@ -49,7 +58,8 @@ Mystring &Mystring::operator=(const Mystring &rhs) {
     if (this == &rhs)
         return *this;
     delete[] str;
-    str = new char[std::strlen(rhs.str) + 1];
+    capacity = std::strlen(rhs.str);
+    str = new char[capacity + 1];
     std::strcpy(str, rhs.str);
     return *this;
 }
@@ -60,7 +70,9 @@ Mystring &Mystring::operator=(Mystring &&rhs) {
         return *this;
     delete[] str;
     str = rhs.str;
+    capacity = rhs.capacity;
     rhs.str = nullptr;
+    rhs.capacity = 0;
     return *this;
 }
 
@@ -122,19 +134,35 @@ Mystring Mystring::operator-() const {
     return temp;
 }
 
-// Concatenation
-Mystring Mystring::operator+(const Mystring &rhs) const {
-    char *buff = new char[std::strlen(str) + std::strlen(rhs.str) + 1];
-    std::strcpy(buff, str);
-    std::strcat(buff, rhs.str);
-    Mystring temp{buff};
-    delete[] buff;
-    return temp;
+// Concatenation: one allocation, the result adopts the joined buffer
+Mystring Mystring::operator+(const Mystring &rhs) const & {
+    return concat(*this, rhs);
+}
+
+// Concatenation on a temporary (e.g. the middle of a + b + c):
+// append into this object and hand it on instead of building a new one
+Mystring Mystring::operator+(const Mystring &rhs) && {
+    *this += rhs;
+    return std::move(*this);
 }
 
-// Concat-assign
+// Concat-assign: copy rhs after the old contents. When it does not fit,
+// grow to at least twice the capacity, so repeated appends (and chains of
+// +) reallocate only O(log n) times
 Mystring &Mystring::operator+=(const Mystring &rhs) {
-    *this = *this + rhs; // reuse operator+
+    const std::size_t len = std::strlen(str);
+    const std::size_t rhs_len = std::strlen(rhs.str);
+    if (len + rhs_len > capacity) {
+        const std::size_t new_capacity = std::max(len + rhs_len, 2 * capacity);
+        char *buff = new char[new_capacity + 1];
+        std::memcpy(buff, str, len);
+        std::memcpy(buff + len, rhs.str, rhs_len + 1); // works for rhs == *this too
+        delete[] str;
+        str = buff;
+        capacity = new_capacity;
+    } else {
+        std::memmove(str + len, rhs.str, rhs_len + 1); // rhs may be *this
+    }
     return *this;
 }
 
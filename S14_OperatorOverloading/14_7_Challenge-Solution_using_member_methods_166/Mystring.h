@@ -1,7 +1,9 @@
 #ifndef _MYSTRING_H_
 #define _MYSTRING_H_
 
-#include <iosfwd> // forward declare std::ostream, std::istream
+#include <iosfwd>  // forward declare std::ostream, std::istream
+#include <cstddef> // std::size_t
+#include <cstring> // std::strlen, std::memcpy (used by concat)
 
 class Mystring
 {
@@ -12,6 +14,25 @@ class Mystring
 private:
     // Pointer to a dynamically allocated null-terminated C string
     char *str;
+    // Characters str can hold (not counting the terminator) before
+    // operator+= has to reallocate
+    std::size_t capacity;
+
+    // Take ownership of an already filled new[] buffer (no copy)
+    struct Adopt {};
+    Mystring(char *buffer, std::size_t length, Adopt);
+
+    // Helpers used by concat to measure and copy each part
+    static std::size_t part_length(const Mystring &part) { return std::strlen(part.str); }
+    static std::size_t part_length(const char *part) { return part ? std::strlen(part) : 0; }
+    static char *copy_part(char *out, const Mystring &part, std::size_t length) {
+        std::memcpy(out, part.str, length);
+        return out + length;
+    }
+    static char *copy_part(char *out, const char *part, std::size_t length) {
+        if (length) std::memcpy(out, part, length);
+        return out + length;
+    }
 
 public:
     // Rule of Five components used here
@@ -32,7 +53,10 @@ public:
 
     // Member operator overloads (challenge focus)
     Mystring operator-() const;                   // lowercase copy
-    Mystring operator+(const Mystring &rhs) const;// concatenation
+    Mystring operator+(const Mystring &rhs) const &;// concatenation
+    Mystring operator+(const Mystring &rhs) &&;     // concatenation reusing this temporary
+                                                    // (a + b + c + d: one allocation for a + b,
+                                                    // then appends that grow it geometrically)
     bool operator==(const Mystring &rhs) const;   // equality
     bool operator!=(const Mystring &rhs) const;   // inequality
     bool operator<(const Mystring &rhs) const;    // lexical less-than
@@ -42,6 +66,27 @@ public:
     Mystring &operator*=(int n);                  // repeat-assign
     Mystring &operator++();                       // pre-increment: make uppercase
     Mystring operator++(int);                     // post-increment: make uppercase
+
+    // Join any number of Mystring / C-string parts with exactly one allocation
+    // (only concat guarantees that; a chain of + can reallocate as it grows):
+    //   Mystring::concat(a, "-", b, c)
+    template <typename... Parts>
+    static Mystring concat(const Parts &...parts);
 };
 
+template <typename... Parts>
+Mystring Mystring::concat(const Parts &...parts) {
+    const std::size_t lengths[] {part_length(parts)..., 0};
+    std::size_t total = 0;
+    for (std::size_t len : lengths)
+        total += len;
+
+    char *buff = new char[total + 1];
+    char *out = buff;
+    std::size_t i = 0;
+    ((out = copy_part(out, parts, lengths[i++])), ...);
+    *out = '\0';
+    return Mystring{buff, total, Adopt{}};
+}
+
 #endif // _MYSTRING_H_
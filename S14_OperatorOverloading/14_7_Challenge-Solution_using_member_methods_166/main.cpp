@@ -61,6 +61,10 @@ int main() {
     repeat_string = "Echo";
     cout << "[Multi-Concat] Echo + Echo + Echo -> " << (repeat_string + repeat_string + repeat_string) << endl;
 
+    // Builder: measure every part, allocate once
+    Mystring joined = Mystring::concat(repeat_string, "-", s1, "-", s2);
+    cout << "[Concat Builder] concat(Echo, -, s1, -, s2) -> " << joined << endl;
+
     // Combine concat-assign with repeat
     repeat_string += (repeat_string * 2);
     cout << "[Combine] Echo += Echo*2 -> " << repeat_string << endl;
@@ -94,9 +98,10 @@ int main() {
 Notes:
 1) Operators implemented as member methods:
    -: lowercase copy
-   +: concatenation
+   +: concatenation (an rvalue left side is appended to and reused)
+   concat(a, b, ...): variadic builder, exactly one allocation
    ==, !=, <, >: comparisons using std::strcmp
-   +=: concat-assign implemented via operator+
+   +=: concat-assign, grows the buffer once and appends
    * : repeat implemented via loop and operator+
    *=: repeat-assign implemented via operator*
    ++ (pre): in-place uppercase, returns *this
@@ -2,106 +2,304 @@
 // Messages are generic and illustrative for learning purposes.
 // --------------------------------------------------------------
 #include <iostream>
+#include <algorithm>
 #include <cstring>
-#include <cctype>
-#include <string>   // used to make operator>> safer
+#include <limits>
+#include <stdexcept>
+#include <locale>
+#include <string>
+#include <utility>
 #include "Mystring.h"
+#include "Mystring_case.h"
+#include "Mystring_hash.h"
+#include "Mystring_utf8.h"
+
+// ===== Storage helpers =====
+
+// Private sizing constructor: buffer for length chars plus '\0'.
+// Short lengths use the inline buffer; the caller fills in the characters.
+Mystring::Mystring(std::size_t length, std::pmr::memory_resource *r MYSTRING_SITE_DEF)
+    : str{sso}, size{length}, capacity{sso_capacity - 1}, resource{r} {
+    MYSTRING_RECORD(construct, 0);
+    if (length > capacity) {
+        str = allocate(length MYSTRING_SITE_ARG);
+        capacity = length;
+    }
+    str[length] = '\0';
+}
+
+// Heap buffers hold chars + 1 bytes and always come from our memory resource
+char *Mystring::allocate(std::size_t chars MYSTRING_SITE_DEF) {
+    MYSTRING_RECORD(allocate, chars + 1);
+    return static_cast<char *>(resource->allocate(chars + 1, alignof(char)));
+}
+
+void Mystring::deallocate() {
+    if (!is_inline())
+        resource->deallocate(str, capacity + 1, alignof(char));
+}
+
+bool Mystring::is_inline() const {
+    return str == sso;
+}
+
+// Release the heap buffer (if any) and fall back to the empty inline string
+void Mystring::release() {
+    deallocate();
+    str = sso;
+    size = 0;
+    capacity = sso_capacity - 1;
+    sso[0] = '\0';
+}
+
+// Take over source's contents (pointer steal, or inline byte copy).
+// Assumes *this holds no heap buffer and both use the same memory resource;
+// source is left as a valid empty string.
+void Mystring::steal(Mystring &source) {
+    if (source.is_inline()) {
+        std::memcpy(sso, source.sso, source.size + 1);
+        str = sso;
+    } else {
+        str = source.str;
+    }
+    size = source.size;
+    capacity = source.capacity;
+    source.str = source.sso;
+    source.size = 0;
+    source.capacity = sso_capacity - 1;
+    source.sso[0] = '\0';
+}
+
+// Replace contents with a copy of s[0..length), reusing the buffer if it fits
+void Mystring::assign(const char *s, std::size_t length) {
+    if (length > capacity) {
+        char *buff = allocate(length);
+        std::memcpy(buff, s, length);
+        release();
+        str = buff;
+        capacity = length;
+    } else {
+        std::memmove(str, s, length);
+    }
+    size = length;
+    str[size] = '\0';
+}
+
+// Append s[0..length); grows at least 2x so repeated appends are amortized O(1)
+void Mystring::append(const char *s, std::size_t length) {
+    if (size + length > capacity) {
+        const bool aliased = s >= str && s <= str + size;   // e.g. s += s
+        const std::size_t offset = aliased ? static_cast<std::size_t>(s - str) : 0;
+        reserve(std::max(size + length, 2 * capacity));
+        if (aliased)
+            s = str + offset;
+    }
+    std::memmove(str + size, s, length);
+    size += length;
+    str[size] = '\0';
+}
 
 // ===== Core special member functions =====
 
-// No-args constructor: create empty string ""
+// No-args constructor: create empty string "" (inline, no allocation)
 Mystring::Mystring()
-    : str{nullptr} {
-    str = new char[1];
-    *str = '\0';
+    : Mystring{std::pmr::get_default_resource()} {
+}
+
+// Empty string whose heap buffers (if any) will come from r
+Mystring::Mystring(std::pmr::memory_resource *r MYSTRING_SITE_DEF)
+    : str{sso}, size{0}, capacity{sso_capacity - 1}, resource{r} {
+    MYSTRING_RECORD(construct, 0);
+    sso[0] = '\0';
 }
 
 // Overloaded constructor: initialize from C string (treat nullptr as empty)
-Mystring::Mystring(const char *s)
-    : str{nullptr} {
-    if (s == nullptr) {
-        str = new char[1];
-        *str = '\0';
-    } else {
-        str = new char[std::strlen(s) + 1];
-        std::strcpy(str, s);
-    }
+Mystring::Mystring(const char *s MYSTRING_SITE_DEF)
+    : Mystring{s, std::pmr::get_default_resource() MYSTRING_SITE_ARG} {
+}
+
+// nullptr alone would be ambiguous between the const char * and the
+// memory_resource * constructors
+Mystring::Mystring(std::nullptr_t MYSTRING_SITE_DEF)
+    : Mystring{std::pmr::get_default_resource() MYSTRING_SITE_ARG} {
+}
+
+Mystring::Mystring(const char *s, std::pmr::memory_resource *r MYSTRING_SITE_DEF)
+    : Mystring{r MYSTRING_SITE_ARG} {
+    MYSTRING_SITE_SCOPE();              // charge assign's allocation to our caller
+    if (s != nullptr)
+        assign(s, std::strlen(s));
+}
+
+// View constructor: materialize an owned copy of the viewed characters
+Mystring::Mystring(Mystring_view v MYSTRING_SITE_DEF)
+    : Mystring{v, std::pmr::get_default_resource() MYSTRING_SITE_ARG} {
 }
 
-// Copy constructor: deep copy
-Mystring::Mystring(const Mystring &source)
-    : str{nullptr} {
-    str = new char[std::strlen(source.str) + 1];
-    std::strcpy(str, source.str);
+Mystring::Mystring(Mystring_view v, std::pmr::memory_resource *r MYSTRING_SITE_DEF)
+    : Mystring{v.size(), r MYSTRING_SITE_ARG} {
+    std::memcpy(str, v.data(), size);
 }
 
-// Move constructor: steal pointer and null out source
-Mystring::Mystring(Mystring &&source)
-    : str{source.str} {
-    source.str = nullptr;
+// Copy constructor: deep copy (inline copy for short strings).
+// Like std::pmr containers, a plain copy uses the default resource, so
+// copying an arena string out of a request scope is always safe.
+Mystring::Mystring(const Mystring &source MYSTRING_SITE_DEF)
+    : Mystring{source, std::pmr::get_default_resource() MYSTRING_SITE_ARG} {
+}
+
+Mystring::Mystring(const Mystring &source, std::pmr::memory_resource *r MYSTRING_SITE_DEF)
+    : Mystring{source.size, r MYSTRING_SITE_ARG} {
+    MYSTRING_RECORD(copy, 0);
+    std::memcpy(str, source.str, size);
+}
+
+// Move constructor: steal heap pointer (and its resource), or copy the
+// inline bytes. The source is left as a valid empty string.
+Mystring::Mystring(Mystring &&source MYSTRING_SITE_DEF) noexcept
+    : Mystring{source.resource MYSTRING_SITE_ARG} {
+    MYSTRING_RECORD(move, 0);
+    steal(source);
 }
 
 // Destructor: release owned memory
 Mystring::~Mystring() {
-    delete[] str;
+    deallocate();
 }
 
-// Copy assignment: deep copy
+// Copy assignment: deep copy (reuses our buffer when it is large enough)
 Mystring &Mystring::operator=(const Mystring &rhs) {
     if (this == &rhs)
         return *this;
+    MYSTRING_RECORD_HERE(copy);
 
-    delete[] str;
-    str = new char[std::strlen(rhs.str) + 1];
-    std::strcpy(str, rhs.str);
+    assign(rhs.str, rhs.size);
     return *this;
 }
 
-// Move assignment: transfer ownership
+// Move assignment: transfer ownership (inline strings are copied).
+// Buffers cannot move between different memory resources, so in that case
+// the characters are copied into our own resource instead.
 Mystring &Mystring::operator=(Mystring &&rhs) {
     if (this == &rhs)
         return *this;
 
-    delete[] str;
-    str = rhs.str;
-    rhs.str = nullptr;
+    if (resource != rhs.resource && !resource->is_equal(*rhs.resource)) {
+        MYSTRING_RECORD_HERE(copy);
+        assign(rhs.str, rhs.size);
+        return *this;
+    }
+    MYSTRING_RECORD_HERE(move);
+    release();
+    steal(rhs);
     return *this;
 }
 
 // ===== Utilities =====
 
 void Mystring::display() const {
-    std::cout << (str ? str : "(null)") << " : " << get_length() << std::endl;
+    std::cout << str << " : " << get_length() << std::endl;
 }
 
 int Mystring::get_length() const {
-    return str ? static_cast<int>(std::strlen(str)) : 0;
+    return static_cast<int>(size);
+}
+
+std::size_t Mystring::get_capacity() const {
+    return capacity;
 }
 
 const char *Mystring::get_str() const {
     return str;
 }
 
+std::pmr::memory_resource *Mystring::get_resource() const {
+    return resource;
+}
+
+// Public assign: replace contents with a copy of v, reusing our buffer
+Mystring &Mystring::assign(Mystring_view v) {
+    assign(v.data(), v.size());
+    return *this;
+}
+
+// Grow storage to hold at least new_capacity characters (never shrinks)
+void Mystring::reserve(std::size_t new_capacity) {
+    if (new_capacity <= capacity)
+        return;
+    char *buff = allocate(new_capacity);
+    std::memcpy(buff, str, size + 1);
+    deallocate();
+    str = buff;
+    capacity = new_capacity;
+}
+
+std::size_t Mystring::hash() const {
+    return static_cast<std::size_t>(hash_bytes(str, size));
+}
+
 // ===== Stream operators (friends) =====
 
 std::ostream &operator<<(std::ostream &os, const Mystring &rhs) {
-    os << (rhs.str ? rhs.str : "");
+    os.write(rhs.str, static_cast<std::streamsize>(rhs.size));
     return os;
 }
 
+// Reads one whitespace-delimited token straight from the stream buffer into
+// rhs, reusing rhs's existing capacity (no temporary string).
+// On failure (nothing extracted) rhs is left unchanged.
 std::istream &operator>>(std::istream &in, Mystring &rhs) {
-    // Read a whitespace-delimited token safely using std::string
-    std::string temp;
-    in >> temp;
-    if (!in) return in;        // input failed; leave rhs unchanged
-    rhs = Mystring{temp.c_str()};
+    const std::istream::sentry ok{in};          // skips leading whitespace
+    if (!ok)
+        return in;
+
+    const auto &ctype = std::use_facet<std::ctype<char>>(in.getloc());
+    std::streambuf *buf = in.rdbuf();
+    std::ios_base::iostate state = std::ios_base::goodbit;
+    bool extracted = false;
+
+    for (auto c = buf->sgetc(); ; c = buf->snextc()) {
+        if (std::char_traits<char>::eq_int_type(c, std::char_traits<char>::eof())) {
+            state |= std::ios_base::eofbit;
+            break;
+        }
+        const char ch = std::char_traits<char>::to_char_type(c);
+        if (ctype.is(std::ctype_base::space, ch))
+            break;
+        if (!extracted) {
+            rhs.size = 0;                       // start over in the existing buffer
+            extracted = true;
+        }
+        if (rhs.size == rhs.capacity)
+            rhs.reserve(2 * rhs.capacity);
+        rhs.str[rhs.size++] = ch;
+    }
+    if (extracted)
+        rhs.str[rhs.size] = '\0';
+    else
+        state |= std::ios_base::failbit;
+    in.width(0);
+    in.setstate(state);
     return in;
 }
 
 // ===== Comparison operators (friends) =====
 
+// Lexical three-way compare on the cached lengths: memcmp over the common
+// prefix (wide loads in the C library), then the shorter string sorts first
+int Mystring::compare(const Mystring &other) const {
+    const std::size_t common = std::min(size, other.size);
+    if (common != 0) {
+        const int result = std::memcmp(str, other.str, common);
+        if (result != 0)
+            return result;
+    }
+    return size < other.size ? -1 : (size > other.size ? 1 : 0);
+}
+
+// Equal strings must have equal lengths, so most mismatches stop there
 bool operator==(const Mystring &lhs, const Mystring &rhs) {
-    return std::strcmp(lhs.str, rhs.str) == 0;
+    return lhs.size == rhs.size && std::memcmp(lhs.str, rhs.str, lhs.size) == 0;
 }
 
 bool operator!=(const Mystring &lhs, const Mystring &rhs) {
@@ -109,64 +307,136 @@ bool operator!=(const Mystring &lhs, const Mystring &rhs) {
 }
 
 bool operator<(const Mystring &lhs, const Mystring &rhs) {
-    return std::strcmp(lhs.str, rhs.str) < 0;
+    return lhs.compare(rhs) < 0;
 }
 
 bool operator>(const Mystring &lhs, const Mystring &rhs) {
-    return std::strcmp(lhs.str, rhs.str) > 0;
+    return lhs.compare(rhs) > 0;
+}
+
+bool operator<=(const Mystring &lhs, const Mystring &rhs) {
+    return lhs.compare(rhs) <= 0;
+}
+
+bool operator>=(const Mystring &lhs, const Mystring &rhs) {
+    return lhs.compare(rhs) >= 0;
 }
 
 // ===== Transform and arithmetic-like operators (friends) =====
 
 // Unary minus: return a lowercase copy
 Mystring operator-(const Mystring &obj) {
-    char *buff = new char[std::strlen(obj.str) + 1];
-    std::strcpy(buff, obj.str);
-    for (size_t i = 0; i < std::strlen(buff); i++) {
-        buff[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(buff[i])));
-    }
-    Mystring temp{buff};
-    delete[] buff;
+    Mystring temp{obj};
+    to_lower_in_place(temp.str, temp.size);
     return temp;
 }
 
-// Concatenation: return lhs + rhs
-Mystring operator+(const Mystring &lhs, const Mystring &rhs) {
-    char *buff = new char[std::strlen(lhs.str) + std::strlen(rhs.str) + 1];
-    std::strcpy(buff, lhs.str);
-    std::strcat(buff, rhs.str);
-    Mystring temp{buff};
-    delete[] buff;
+// Unary minus on a temporary: lowercase its buffer in place, no allocation
+Mystring operator-(Mystring &&obj) {
+    to_lower_in_place(obj.str, obj.size);
+    return std::move(obj);
+}
+
+// UTF-8 case fold: folding never changes the encoded length, so the copy
+// is folded straight into a buffer of the same size
+Mystring fold_case(const Mystring &obj) {
+    Mystring temp{obj.size};
+    utf8_fold_case(obj.str, obj.size, temp.str);
     return temp;
 }
 
-// Concat-assign: reuse operator+
+Mystring fold_case(Mystring &&obj) {
+    utf8_fold_case(obj.str, obj.size, obj.str);
+    return std::move(obj);
+}
+
+Mystring &fold_case_in_place(Mystring &obj) {
+    utf8_fold_case(obj.str, obj.size, obj.str);
+    return obj;
+}
+
+// Concatenation: return lhs + rhs (built directly in the result's buffer)
+Mystring operator+(const Mystring &lhs, const Mystring &rhs) {
+    return Mystring::concat(lhs, rhs);
+}
+
+// Concatenation on a temporary lhs (e.g. the middle of a + b + c):
+// append into its buffer and hand it on instead of building a new string
+Mystring operator+(Mystring &&lhs, const Mystring &rhs) {
+    lhs.append(rhs.str, rhs.size);
+    return std::move(lhs);
+}
+
+// Concatenation onto a temporary rhs (e.g. "Left" + Mystring{"Right"}):
+// shift rhs right and copy lhs in front when its buffer is large enough
+Mystring operator+(const Mystring &lhs, Mystring &&rhs) {
+    if (&lhs == &rhs || lhs.size + rhs.size > rhs.capacity)
+        return lhs + static_cast<const Mystring &>(rhs);
+    std::memmove(rhs.str + lhs.size, rhs.str, rhs.size + 1);
+    std::memcpy(rhs.str, lhs.str, lhs.size);
+    rhs.size += lhs.size;
+    return std::move(rhs);
+}
+
+Mystring operator+(Mystring &&lhs, Mystring &&rhs) {
+    return std::move(lhs) + static_cast<const Mystring &>(rhs);
+}
+
+// Concat-assign: append in place (amortized O(1) per character)
 Mystring &operator+=(Mystring &lhs, const Mystring &rhs) {
-    lhs = lhs + rhs;
+    lhs.append(rhs.str, rhs.size);
     return lhs;
 }
 
-// Repeat n times
+// Size of a string repeated n times; n <= 0 gives the empty string
+static std::size_t repeated_size(std::size_t unit, int n) {
+    if (n <= 0 || unit == 0)
+        return 0;
+    if (unit > std::numeric_limits<std::size_t>::max() / 2 / static_cast<std::size_t>(n))
+        throw std::length_error{"Mystring: repeated string too long"};
+    return unit * static_cast<std::size_t>(n);
+}
+
+// dest[0..unit) already holds one copy; fill dest[0..total) by doubling
+// the filled prefix, so only O(log n) memcpy calls are needed
+static void fill_repeated(char *dest, std::size_t unit, std::size_t total) {
+    std::size_t filled = unit;
+    while (filled < total) {
+        const std::size_t chunk = std::min(filled, total - filled);
+        std::memcpy(dest + filled, dest, chunk);
+        filled += chunk;
+    }
+}
+
+// Repeat n times: size the result once, then fill it
 Mystring operator*(const Mystring &lhs, int n) {
-    Mystring temp;
-    for (int i = 1; i <= n; i++)
-        temp = temp + lhs;
+    const std::size_t total = repeated_size(lhs.size, n);
+    Mystring temp{total};
+    if (total > 0) {
+        std::memcpy(temp.str, lhs.str, lhs.size);
+        fill_repeated(temp.str, lhs.size, total);
+    }
     return temp;
-
-    // For better performance with large n, build once in a single buffer.
 }
 
-// Repeat-assign
+// Repeat-assign: grow lhs once and fill it in place
 Mystring &operator*=(Mystring &lhs, int n) {
-    lhs = lhs * n;
+    const std::size_t total = repeated_size(lhs.size, n);
+    if (total == 0) {
+        lhs.size = 0;
+        lhs.str[0] = '\0';
+        return lhs;
+    }
+    lhs.reserve(total);
+    fill_repeated(lhs.str, lhs.size, total);
+    lhs.size = total;
+    lhs.str[total] = '\0';
     return lhs;
 }
 
 // Pre-increment: uppercase in place, return reference
 Mystring &operator++(Mystring &obj) {
-    for (size_t i = 0; i < std::strlen(obj.str); i++) {
-        obj.str[i] = static_cast<char>(std::toupper(static_cast<unsigned char>(obj.str[i])));
-    }
+    to_upper_in_place(obj.str, obj.size);
     return obj;
 }
 
@@ -6,6 +6,31 @@
 //   - For symmetric operators like +, ==, etc., non-member overloads
 //     allow implicit conversions on both operands.
 //
+// Small-string optimization (SSO):
+//   - Strings shorter than sso_capacity characters are kept in an inline
+//     buffer inside the object, so they never touch the heap.
+//   - Longer strings live in a heap buffer, exactly as before.
+//
+// Memory resource:
+//   - Heap buffers come from a std::pmr::memory_resource (the default
+//     resource unless one is passed to a constructor), so request-scoped
+//     strings can live in a Mystring_arena and be freed in one reset().
+//
+// Size and capacity:
+//   - The length and the usable capacity are cached, so get_length() is O(1)
+//     and no operator needs std::strlen on its own data.
+//   - Appends grow the buffer geometrically (like std::string), so repeated
+//     += on a long-lived string is amortized O(1) per appended character.
+//
+// UTF-8:
+//   - get_length() counts bytes and operator- / operator++ convert ASCII
+//     letters only. utf8_valid(), utf8_length() and fold_case() treat the
+//     bytes as UTF-8 text (see Mystring_utf8.h).
+//
+// Instrumentation:
+//   - Build with -DMYSTRING_INSTRUMENT -std=c++20 to count constructions,
+//     copies, moves and allocations per call site (see Mystring_instrument.h).
+//
 // Notes:
 //   - This is an educational example. In production, prefer std::string.
 // --------------------------------------------------------------
@@ -13,33 +38,84 @@
 #define _MYSTRING_H_
 
 #include <iosfwd>  // forward declare std::istream and std::ostream
+#include <cstddef> // std::size_t
+#include <cstring> // std::strlen, std::memcpy (used by concat)
+#include <functional> // std::hash
+#include <memory_resource> // std::pmr::memory_resource
+#include "Mystring_view.h"
+#include "Mystring_instrument.h"
 
 class Mystring
 {
     // Friend operator overloads (non-member)
     friend Mystring operator-(const Mystring &obj);                       // lowercase copy
+    friend Mystring operator-(Mystring &&obj);                            // lowercase in place
     friend Mystring operator+(const Mystring &lhs, const Mystring &rhs);  // concatenation
+    friend Mystring operator+(Mystring &&lhs, const Mystring &rhs);       // append into lhs's buffer
+    friend Mystring operator+(const Mystring &lhs, Mystring &&rhs);       // prepend into rhs's buffer
+    friend Mystring operator+(Mystring &&lhs, Mystring &&rhs);            // append into lhs's buffer
     friend bool     operator==(const Mystring &lhs, const Mystring &rhs); // equals
     friend bool     operator!=(const Mystring &lhs, const Mystring &rhs); // not equals
     friend bool     operator<(const Mystring &lhs, const Mystring &rhs);  // lexical less-than
     friend bool     operator>(const Mystring &lhs, const Mystring &rhs);  // lexical greater-than
+    friend bool     operator<=(const Mystring &lhs, const Mystring &rhs); // lexical less-or-equal
+    friend bool     operator>=(const Mystring &lhs, const Mystring &rhs); // lexical greater-or-equal
     friend Mystring &operator+=(Mystring &lhs, const Mystring &rhs);      // concat-assign
     friend Mystring operator*(const Mystring &lhs, int n);                // repeat n times
     friend Mystring &operator*=(Mystring &lhs, int n);                    // repeat-assign
     friend Mystring &operator++(Mystring &obj);                           // pre-increment: uppercase
     friend Mystring operator++(Mystring &obj, int);                       // post-increment: uppercase
+    friend Mystring fold_case(const Mystring &obj);                       // UTF-8 case-folded copy
+    friend Mystring fold_case(Mystring &&obj);                            // UTF-8 case fold in place
+    friend Mystring &fold_case_in_place(Mystring &obj);                   // UTF-8 case fold in place
     friend std::ostream &operator<<(std::ostream &os, const Mystring &rhs);
     friend std::istream &operator>>(std::istream &in, Mystring &rhs);
 
 private:
-    char *str;      // pointer to a null-terminated C string
+    static constexpr std::size_t sso_capacity = 16;  // inline bytes, including '\0'
+
+    char *str;                  // points to sso or to a heap buffer (null-terminated)
+    std::size_t size;           // number of characters, excluding '\0'
+    std::size_t capacity;       // characters str can hold, excluding '\0'
+    char sso[sso_capacity];     // inline storage for short strings
+    std::pmr::memory_resource *resource;    // source of heap buffers (never null)
+
+    // uninitialized buffer for length chars
+    explicit Mystring(std::size_t length, std::pmr::memory_resource *r = std::pmr::get_default_resource() MYSTRING_SITE);
+    char *allocate(std::size_t chars MYSTRING_SITE); // heap buffer for chars + '\0' from resource
+    void deallocate();                      // return the heap buffer (if any) to resource
+    bool is_inline() const;                 // true when str points to sso
+    void assign(const char *s, std::size_t length); // replace contents with a copy
+    void append(const char *s, std::size_t length); // append with geometric growth
+    void steal(Mystring &source);           // take source's buffer, leave it empty
+    void release();                         // free heap buffer (if any), point to sso
+
+    // Helpers used by concat to measure and copy each part
+    static std::size_t part_length(const Mystring &part) { return part.size; }
+    static std::size_t part_length(const char *part) { return part ? std::strlen(part) : 0; }
+    static char *copy_part(char *out, const Mystring &part, std::size_t length) {
+        std::memcpy(out, part.str, length);
+        return out + length;
+    }
+    static char *copy_part(char *out, const char *part, std::size_t length) {
+        if (length) std::memcpy(out, part, length);
+        return out + length;
+    }
 
 public:
     // Rule of Five components used here
     Mystring();                           // No-args constructor
-    Mystring(const char *s);              // Overloaded constructor
-    Mystring(const Mystring &source);     // Copy constructor (deep copy)
-    Mystring(Mystring &&source);          // Move constructor (steal pointer)
+    Mystring(const char *s MYSTRING_SITE);            // Overloaded constructor
+    Mystring(std::nullptr_t MYSTRING_SITE);           // empty, as Mystring(const char *) treats nullptr
+    explicit Mystring(Mystring_view v MYSTRING_SITE); // owned copy of a view
+    Mystring(const Mystring &source MYSTRING_SITE);   // Copy constructor (deep copy, default resource)
+
+    // Allocator-aware constructors: heap buffers come from r (e.g. a Mystring_arena)
+    explicit Mystring(std::pmr::memory_resource *r MYSTRING_SITE);
+    Mystring(const char *s, std::pmr::memory_resource *r MYSTRING_SITE);
+    Mystring(Mystring_view v, std::pmr::memory_resource *r MYSTRING_SITE);
+    Mystring(const Mystring &source, std::pmr::memory_resource *r MYSTRING_SITE);
+    Mystring(Mystring &&source MYSTRING_SITE) noexcept; // Move constructor (steal pointer)
     ~Mystring();                          // Destructor
 
     // Assignments
@@ -48,8 +124,52 @@ public:
 
     // Utilities
     void        display() const;              // print value and length
-    int         get_length() const;           // number of characters
+    int         get_length() const;           // number of characters (O(1))
+    std::size_t get_capacity() const;         // characters storable without reallocating
     const char *get_str() const;              // raw pointer (read-only)
+    std::pmr::memory_resource *get_resource() const; // where heap buffers come from
+    void        reserve(std::size_t new_capacity); // grow storage ahead of appends
+    Mystring   &assign(Mystring_view v);      // copy v in, reusing existing capacity
+
+    // Three-way compare: <0, 0 or >0 (one pass, like std::string::compare)
+    int         compare(const Mystring &other) const;
+
+    // Non-owning views of the characters (substr, find, split, ... see Mystring_view.h)
+    operator Mystring_view() const { return Mystring_view{str, size}; }
+    Mystring_view view() const { return Mystring_view{str, size}; }
+
+    // Fast non-cryptographic hash of the characters (see Mystring_hash.h)
+    std::size_t hash() const;
+
+    // Join any number of Mystring / C-string parts with at most one allocation
+    // (none if the result fits inline). Only concat guarantees that: a + b +
+    // c + d allocates for a + b, then appends into that buffer, which grows
+    // geometrically and may reallocate.
+    //   Mystring::concat(a, "-", b, c)
+    template <typename... Parts>
+    static Mystring concat(const Parts &...parts);
+};
+
+template <typename... Parts>
+Mystring Mystring::concat(const Parts &...parts) {
+    const std::size_t lengths[] {part_length(parts)..., 0};
+    std::size_t total = 0;
+    for (std::size_t len : lengths)
+        total += len;
+
+    Mystring result{total};
+    char *out = result.str;
+    std::size_t i = 0;
+    ((out = copy_part(out, parts, lengths[i++])), ...);
+    return result;
+}
+
+// Lets Mystring key std::unordered_map / std::unordered_set
+namespace std {
+template <>
+struct hash<Mystring> {
+    std::size_t operator()(const Mystring &s) const { return s.hash(); }
 };
+} // namespace std
 
 #endif // _MYSTRING_H_
@@ -0,0 +1,62 @@
+// Implements the bump-pointer arena.
+// --------------------------------------------------------------
+#include <algorithm>
+#include <cstdint>
+#include "Mystring_arena.h"
+
+Mystring_arena::Mystring_arena(std::size_t chunk_size)
+    : current{0}, offset{0}, chunk_size{std::max<std::size_t>(chunk_size, 64)}, used{0} {
+}
+
+// Move to the next chunk that can hold min_bytes, creating one if needed.
+// Oversized requests get a dedicated chunk of exactly their size.
+void Mystring_arena::next_chunk(std::size_t min_bytes) {
+    while (!chunks.empty() && current + 1 < chunks.size()) {
+        ++current;
+        offset = 0;
+        if (chunks[current].size >= min_bytes)
+            return;
+    }
+    const std::size_t size = std::max(chunk_size, min_bytes);
+    chunks.push_back(Chunk{std::make_unique<std::byte[]>(size), size});
+    current = chunks.size() - 1;
+    offset = 0;
+}
+
+void *Mystring_arena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    for (;;) {
+        if (!chunks.empty()) {
+            Chunk &chunk = chunks[current];
+            const auto base = reinterpret_cast<std::uintptr_t>(chunk.data.get());
+            const std::uintptr_t aligned = (base + offset + alignment - 1) & ~(std::uintptr_t{alignment} - 1);
+            const std::size_t start = static_cast<std::size_t>(aligned - base);
+            if (start + bytes <= chunk.size) {
+                offset = start + bytes;
+                used += bytes;
+                return chunk.data.get() + start;
+            }
+        }
+        next_chunk(bytes + alignment);
+    }
+}
+
+// Individual frees are no-ops; memory comes back in reset()
+void Mystring_arena::do_deallocate(void *, std::size_t, std::size_t) {
+}
+
+bool Mystring_arena::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+    return this == &other;
+}
+
+void Mystring_arena::reset() {
+    current = 0;
+    offset = 0;
+    used = 0;
+}
+
+std::size_t Mystring_arena::bytes_reserved() const {
+    std::size_t total = 0;
+    for (const Chunk &chunk : chunks)
+        total += chunk.size;
+    return total;
+}
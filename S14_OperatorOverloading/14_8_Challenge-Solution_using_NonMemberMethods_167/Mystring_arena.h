@@ -0,0 +1,57 @@
+// Mystring_arena: a bump-pointer std::pmr::memory_resource.
+//
+// Allocation just advances a pointer inside the current chunk; deallocate()
+// does nothing. reset() releases everything at once and keeps the chunks
+// for the next round, so a parse-then-discard loop allocates from the
+// system only until the arena has warmed up.
+//
+//   Mystring_arena arena;
+//   for (each request) {
+//       Mystring s{token, &arena};   // heap part (if any) lives in the arena
+//       ...
+//       arena.reset();              // every string from this request is gone
+//   }
+//
+// Strings built on the arena must be destroyed (or never used again)
+// before reset(). Not thread-safe: use one arena per thread.
+// --------------------------------------------------------------
+#ifndef _MYSTRING_ARENA_H_
+#define _MYSTRING_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+class Mystring_arena : public std::pmr::memory_resource
+{
+private:
+    struct Chunk {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size;
+    };
+
+    std::vector<Chunk> chunks;
+    std::size_t current;        // index of the chunk being filled
+    std::size_t offset;         // bytes used in chunks[current]
+    std::size_t chunk_size;     // size of regular chunks
+    std::size_t used;           // bytes handed out since the last reset
+
+    void next_chunk(std::size_t min_bytes);
+
+protected:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+public:
+    explicit Mystring_arena(std::size_t chunk_size = 64 * 1024);
+    Mystring_arena(const Mystring_arena &) = delete;
+    Mystring_arena &operator=(const Mystring_arena &) = delete;
+
+    void reset();                               // free everything, keep chunks
+    std::size_t bytes_used() const { return used; }
+    std::size_t bytes_reserved() const;         // total chunk memory held
+};
+
+#endif // _MYSTRING_ARENA_H_
@@ -0,0 +1,76 @@
+// Implements the SIMD/scalar case conversion kernels.
+// --------------------------------------------------------------
+#include <cctype>
+#include "Mystring_case.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Scalar fallback: locale-aware, one byte at a time
+void scalar_lower(char *s, std::size_t length) {
+    for (std::size_t i = 0; i < length; i++)
+        s[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(s[i])));
+}
+
+void scalar_upper(char *s, std::size_t length) {
+    for (std::size_t i = 0; i < length; i++)
+        s[i] = static_cast<char>(std::toupper(static_cast<unsigned char>(s[i])));
+}
+
+// Convert every byte in [first, last] by toggling the 0x20 bit.
+// lower: first='A', last='Z'; upper: first='a', last='z'.
+// Returns the number of bytes processed; the caller finishes the tail.
+std::size_t simd_convert(char *s, std::size_t length, char first, char last, bool lower) {
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i lo = _mm256_set1_epi8(static_cast<char>(first - 1));
+    const __m256i hi = _mm256_set1_epi8(static_cast<char>(last + 1));
+    const __m256i bit = _mm256_set1_epi8(0x20);
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+        if (_mm256_movemask_epi8(v) != 0) {        // non-ASCII byte present
+            lower ? scalar_lower(s + i, 32) : scalar_upper(s + i, 32);
+            continue;
+        }
+        // ASCII only, so signed compares are safe
+        const __m256i in_range = _mm256_and_si256(_mm256_cmpgt_epi8(v, lo), _mm256_cmpgt_epi8(hi, v));
+        v = _mm256_xor_si256(v, _mm256_and_si256(in_range, bit));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(s + i), v);
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i lo16 = _mm_set1_epi8(static_cast<char>(first - 1));
+    const __m128i hi16 = _mm_set1_epi8(static_cast<char>(last + 1));
+    const __m128i bit16 = _mm_set1_epi8(0x20);
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+        if (_mm_movemask_epi8(v) != 0) {
+            lower ? scalar_lower(s + i, 16) : scalar_upper(s + i, 16);
+            continue;
+        }
+        const __m128i in_range = _mm_and_si128(_mm_cmpgt_epi8(v, lo16), _mm_cmpgt_epi8(hi16, v));
+        v = _mm_xor_si128(v, _mm_and_si128(in_range, bit16));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(s + i), v);
+    }
+#else
+    (void)s; (void)length; (void)first; (void)last; (void)lower;
+#endif
+    return i;
+}
+
+} // namespace
+
+void to_lower_in_place(char *s, std::size_t length) {
+    const std::size_t done = simd_convert(s, length, 'A', 'Z', true);
+    scalar_lower(s + done, length - done);
+}
+
+void to_upper_in_place(char *s, std::size_t length) {
+    const std::size_t done = simd_convert(s, length, 'a', 'z', false);
+    scalar_upper(s + done, length - done);
+}
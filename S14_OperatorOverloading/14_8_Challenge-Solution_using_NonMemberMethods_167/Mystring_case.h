@@ -0,0 +1,19 @@
+// Case conversion kernels used by Mystring's operator- and operator++.
+//
+// ASCII bytes are converted 32 (AVX2) or 16 (SSE2) at a time. A block that
+// contains any non-ASCII byte (>= 0x80) is handed to the scalar
+// std::tolower / std::toupper path, so results match the original
+// byte-at-a-time loop in the default "C" locale.
+//
+// Build with -mavx2 (or -march=native) to enable the 32-byte path;
+// SSE2 is always available on x86-64. Other targets use the scalar loop.
+// --------------------------------------------------------------
+#ifndef _MYSTRING_CASE_H_
+#define _MYSTRING_CASE_H_
+
+#include <cstddef>
+
+void to_lower_in_place(char *s, std::size_t length);
+void to_upper_in_place(char *s, std::size_t length);
+
+#endif // _MYSTRING_CASE_H_
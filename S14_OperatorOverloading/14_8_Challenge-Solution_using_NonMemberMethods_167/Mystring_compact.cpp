@@ -0,0 +1,161 @@
+// Implements the 16-byte prefix-inlined string.
+// --------------------------------------------------------------
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include "Mystring.h"
+#include "Mystring_compact.h"
+#include "Mystring_hash.h"
+
+static_assert(sizeof(Compact_Mystring) == 16, "Compact_Mystring must stay 16 bytes");
+
+namespace {
+
+// Four characters as a big-endian integer: integer order == byte order
+std::uint32_t prefix_key(const char *p) {
+    const auto *b = reinterpret_cast<const unsigned char *>(p);
+    return (std::uint32_t{b[0]} << 24) | (std::uint32_t{b[1]} << 16) | (std::uint32_t{b[2]} << 8) | b[3];
+}
+
+} // namespace
+
+// ===== Construction =====
+
+// Inline: copy into prefix + rest with zero padding (so == can compare the
+// padded 8-byte tail in one go). Heap: keep the prefix and all characters.
+void Compact_Mystring::init(const char *s, std::size_t n) {
+    static_assert(offsetof(Compact_Mystring, rest) == offsetof(Compact_Mystring, prefix) + prefix_size,
+                  "data() reads prefix and rest as one array");
+    if (n > std::numeric_limits<std::uint32_t>::max())
+        throw std::length_error{"Compact_Mystring: string longer than 4 GB"};
+    length = static_cast<std::uint32_t>(n);
+    std::memset(prefix, 0, sizeof prefix);
+    std::memset(rest, 0, sizeof rest);
+    if (n <= inline_capacity) {
+        if (n != 0)
+            std::memcpy(prefix, s, std::min(n, prefix_size));
+        if (n > prefix_size)
+            std::memcpy(rest, s + prefix_size, n - prefix_size);
+    } else {
+        std::memcpy(prefix, s, prefix_size);
+        heap = new char[n + 1];
+        std::memcpy(heap, s, n);
+        heap[n] = '\0';
+    }
+}
+
+Compact_Mystring::Compact_Mystring() {
+    init(nullptr, 0);
+}
+
+Compact_Mystring::Compact_Mystring(const char *s) {
+    init(s, s ? std::strlen(s) : 0);
+}
+
+Compact_Mystring::Compact_Mystring(Mystring_view v) {
+    init(v.data(), v.size());
+}
+
+Compact_Mystring::Compact_Mystring(const Mystring &s) {
+    init(s.get_str(), static_cast<std::size_t>(s.get_length()));
+}
+
+Compact_Mystring::Compact_Mystring(const Compact_Mystring &source) {
+    init(source.data(), source.length);
+}
+
+// All 16 bytes are copied; the source keeps a valid empty value
+Compact_Mystring::Compact_Mystring(Compact_Mystring &&source) noexcept {
+    steal(source);
+}
+
+// Take all 16 bytes of source (the heap pointer, if any) and leave it empty
+void Compact_Mystring::steal(Compact_Mystring &source) noexcept {
+    std::memcpy(static_cast<void *>(this), &source, sizeof *this);
+    source.length = 0;
+    std::memset(source.prefix, 0, sizeof source.prefix);
+    std::memset(source.rest, 0, sizeof source.rest);
+}
+
+Compact_Mystring::~Compact_Mystring() {
+    if (!is_inline())
+        delete[] heap;
+}
+
+Compact_Mystring &Compact_Mystring::operator=(const Compact_Mystring &rhs) {
+    if (this != &rhs)
+        *this = Compact_Mystring{rhs};
+    return *this;
+}
+
+Compact_Mystring &Compact_Mystring::operator=(Compact_Mystring &&rhs) noexcept {
+    if (this != &rhs) {
+        if (!is_inline())
+            delete[] heap;
+        steal(rhs);
+    }
+    return *this;
+}
+
+Mystring Compact_Mystring::to_mystring() const {
+    return Mystring{view()};
+}
+
+// ===== Comparison =====
+
+// Prefixes first (no pointer hop); only equal prefixes look at the rest
+int Compact_Mystring::compare(const Compact_Mystring &other) const {
+    const std::uint32_t a = prefix_key(prefix);
+    const std::uint32_t b = prefix_key(other.prefix);
+    if (a != b)
+        return a < b ? -1 : 1;
+    const std::size_t common = std::min(length, other.length);
+    if (common > prefix_size) {
+        const int result = std::memcmp(data() + prefix_size, other.data() + prefix_size, common - prefix_size);
+        if (result != 0)
+            return result;
+    }
+    return length < other.length ? -1 : (length > other.length ? 1 : 0);
+}
+
+// Length and prefix are the first 8 bytes: one comparison rejects most
+// mismatches. Short strings then compare their zero-padded tails in place.
+bool operator==(const Compact_Mystring &lhs, const Compact_Mystring &rhs) {
+    if (std::memcmp(&lhs, &rhs, 8) != 0)
+        return false;
+    if (lhs.is_inline())
+        return std::memcmp(lhs.rest, rhs.rest, sizeof lhs.rest) == 0;
+    return std::memcmp(lhs.heap + Compact_Mystring::prefix_size, rhs.heap + Compact_Mystring::prefix_size,
+                       lhs.length - Compact_Mystring::prefix_size) == 0;
+}
+
+bool operator!=(const Compact_Mystring &lhs, const Compact_Mystring &rhs) {
+    return !(lhs == rhs);
+}
+
+bool operator<(const Compact_Mystring &lhs, const Compact_Mystring &rhs) {
+    return lhs.compare(rhs) < 0;
+}
+
+bool operator>(const Compact_Mystring &lhs, const Compact_Mystring &rhs) {
+    return lhs.compare(rhs) > 0;
+}
+
+bool operator<=(const Compact_Mystring &lhs, const Compact_Mystring &rhs) {
+    return lhs.compare(rhs) <= 0;
+}
+
+bool operator>=(const Compact_Mystring &lhs, const Compact_Mystring &rhs) {
+    return lhs.compare(rhs) >= 0;
+}
+
+std::size_t Compact_Mystring::hash() const {
+    return static_cast<std::size_t>(hash_bytes(data(), length));
+}
+
+std::ostream &operator<<(std::ostream &os, const Compact_Mystring &rhs) {
+    return os << rhs.view();
+}
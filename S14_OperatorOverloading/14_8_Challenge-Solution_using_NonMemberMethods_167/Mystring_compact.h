@@ -0,0 +1,85 @@
+// Compact_Mystring: 16-byte "German string" layout for compare-heavy data.
+//
+//   +----------+-----------+--------------------------------+
+//   | length   | prefix    | rest of the chars (length<=12) |
+//   | 4 bytes  | 4 chars   | or pointer to all chars (>12)  |
+//   +----------+-----------+--------------------------------+
+//
+// The length and the first 4 characters are always inside the object, so
+// most comparisons (sorting, binary search, hash-table probes) are decided
+// without touching the heap: different lengths or prefixes settle ==, and
+// different prefixes settle <. Strings of up to 12 characters never
+// allocate at all. Mystring needs 48 bytes and a pointer hop for the same
+// checks; four Compact_Mystrings fit in one cache line.
+//
+// Values are immutable (build a Mystring to edit, then convert). Inline
+// values are not null-terminated: use view() or to_mystring(), not a char*.
+// Lengths are limited to 4 GB - 1.
+// --------------------------------------------------------------
+#ifndef _MYSTRING_COMPACT_H_
+#define _MYSTRING_COMPACT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include "Mystring_view.h"
+
+class Mystring;
+
+class Compact_Mystring
+{
+    friend bool operator==(const Compact_Mystring &lhs, const Compact_Mystring &rhs);
+    friend bool operator!=(const Compact_Mystring &lhs, const Compact_Mystring &rhs);
+    friend bool operator<(const Compact_Mystring &lhs, const Compact_Mystring &rhs);
+    friend bool operator>(const Compact_Mystring &lhs, const Compact_Mystring &rhs);
+    friend bool operator<=(const Compact_Mystring &lhs, const Compact_Mystring &rhs);
+    friend bool operator>=(const Compact_Mystring &lhs, const Compact_Mystring &rhs);
+    friend std::ostream &operator<<(std::ostream &os, const Compact_Mystring &rhs);
+
+private:
+    static constexpr std::size_t prefix_size = 4;
+    static constexpr std::size_t inline_capacity = 12;    // prefix + 8 more chars
+
+    std::uint32_t length;
+    char prefix[prefix_size];       // first chars, zero-padded
+    union {
+        char rest[inline_capacity - prefix_size];   // chars 4..11, zero-padded (short)
+        char *heap;                                 // all chars + '\0' (long)
+    };
+
+    bool is_inline() const { return length <= inline_capacity; }
+    void init(const char *s, std::size_t n);
+    void steal(Compact_Mystring &source) noexcept;
+
+public:
+    Compact_Mystring();
+    Compact_Mystring(const char *s);
+    explicit Compact_Mystring(Mystring_view v);
+    explicit Compact_Mystring(const Mystring &s);
+    Compact_Mystring(const Compact_Mystring &source);
+    Compact_Mystring(Compact_Mystring &&source) noexcept;
+    ~Compact_Mystring();
+
+    Compact_Mystring &operator=(const Compact_Mystring &rhs);
+    Compact_Mystring &operator=(Compact_Mystring &&rhs) noexcept;
+
+    int           get_length() const { return static_cast<int>(length); }
+    const char   *data() const { return is_inline() ? prefix : heap; }  // not null-terminated
+    Mystring_view view() const { return Mystring_view{data(), length}; }
+    operator Mystring_view() const { return view(); }
+    Mystring      to_mystring() const;
+
+    // Three-way compare, same order as Mystring::compare
+    int         compare(const Compact_Mystring &other) const;
+    std::size_t hash() const;       // same value as std::hash<Mystring>
+};
+
+namespace std {
+template <>
+struct hash<Compact_Mystring> {
+    std::size_t operator()(const Compact_Mystring &s) const { return s.hash(); }
+};
+} // namespace std
+
+#endif // _MYSTRING_COMPACT_H_
@@ -0,0 +1,223 @@
+// Implements the copy-on-write string.
+// --------------------------------------------------------------
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include "Mystring.h"
+#include "Mystring_case.h"
+#include "Mystring_cow.h"
+
+// ===== Block management =====
+
+Cow_Mystring::Block *Cow_Mystring::allocate(std::size_t capacity) {
+    void *raw = ::operator new(sizeof(Block) + capacity + 1);
+    Block *b = new (raw) Block;
+    b->refs.store(1, std::memory_order_relaxed);
+    b->size = 0;
+    b->capacity = capacity;
+    b->chars()[0] = '\0';
+    return b;
+}
+
+// Drop one reference; the last owner frees the block
+void Cow_Mystring::release(Block *b) {
+    if (b && b->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        b->~Block();
+        ::operator delete(b);
+    }
+}
+
+// Called before every mutation: afterwards block is owned by this object
+// alone and can hold min_capacity characters
+void Cow_Mystring::make_unique(std::size_t min_capacity) {
+    if (block && block->refs.load(std::memory_order_acquire) == 1 && block->capacity >= min_capacity)
+        return;
+    const std::size_t size = block ? block->size : 0;
+    const std::size_t old_capacity = block ? block->capacity : 0;
+    // Grow geometrically only when the caller actually needs more room
+    const std::size_t capacity = min_capacity > old_capacity ? std::max(min_capacity, 2 * old_capacity)
+                                                             : old_capacity;
+    Block *copy = allocate(capacity);
+    if (block)
+        std::memcpy(copy->chars(), block->chars(), size + 1);
+    copy->size = size;
+    release(block);
+    block = copy;
+}
+
+// ===== Special members =====
+
+Cow_Mystring::Cow_Mystring()
+    : block{nullptr} {
+}
+
+Cow_Mystring::Cow_Mystring(const char *s)
+    : Cow_Mystring{Mystring_view{s}} {
+}
+
+Cow_Mystring::Cow_Mystring(Mystring_view v)
+    : block{nullptr} {
+    if (!v.empty()) {
+        block = allocate(v.size());
+        std::memcpy(block->chars(), v.data(), v.size());
+        block->size = v.size();
+        block->chars()[v.size()] = '\0';
+    }
+}
+
+Cow_Mystring::Cow_Mystring(const Mystring &s)
+    : Cow_Mystring{s.view()} {
+}
+
+Cow_Mystring::Cow_Mystring(const Cow_Mystring &source)
+    : block{source.block} {
+    if (block)
+        block->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+Cow_Mystring::Cow_Mystring(Cow_Mystring &&source) noexcept
+    : block{source.block} {
+    source.block = nullptr;
+}
+
+Cow_Mystring::~Cow_Mystring() {
+    release(block);
+}
+
+Cow_Mystring &Cow_Mystring::operator=(const Cow_Mystring &rhs) {
+    if (block == rhs.block)
+        return *this;
+    if (rhs.block)
+        rhs.block->refs.fetch_add(1, std::memory_order_relaxed);
+    release(block);
+    block = rhs.block;
+    return *this;
+}
+
+Cow_Mystring &Cow_Mystring::operator=(Cow_Mystring &&rhs) noexcept {
+    if (this == &rhs)
+        return *this;
+    release(block);
+    block = rhs.block;
+    rhs.block = nullptr;
+    return *this;
+}
+
+// ===== Accessors =====
+
+int Cow_Mystring::get_length() const {
+    return block ? static_cast<int>(block->size) : 0;
+}
+
+const char *Cow_Mystring::get_str() const {
+    return block ? block->chars() : "";
+}
+
+std::size_t Cow_Mystring::use_count() const {
+    return block ? block->refs.load(std::memory_order_relaxed) : 0;
+}
+
+Cow_Mystring::operator Mystring_view() const {
+    return Mystring_view{get_str(), static_cast<std::size_t>(get_length())};
+}
+
+Mystring Cow_Mystring::to_mystring() const {
+    return Mystring{static_cast<Mystring_view>(*this)};
+}
+
+// ===== Operators =====
+
+Cow_Mystring operator+(const Cow_Mystring &lhs, const Cow_Mystring &rhs) {
+    if (!rhs.block)
+        return lhs;                     // shares lhs, no copy
+    if (!lhs.block)
+        return rhs;
+    Cow_Mystring temp;
+    temp.block = Cow_Mystring::allocate(lhs.block->size + rhs.block->size);
+    std::memcpy(temp.block->chars(), lhs.block->chars(), lhs.block->size);
+    std::memcpy(temp.block->chars() + lhs.block->size, rhs.block->chars(), rhs.block->size + 1);
+    temp.block->size = lhs.block->size + rhs.block->size;
+    return temp;
+}
+
+Cow_Mystring operator-(const Cow_Mystring &obj) {
+    Cow_Mystring temp{obj};
+    if (temp.block) {
+        temp.make_unique(temp.block->size);
+        to_lower_in_place(temp.block->chars(), temp.block->size);
+    }
+    return temp;
+}
+
+Cow_Mystring &operator+=(Cow_Mystring &lhs, const Cow_Mystring &rhs) {
+    if (!rhs.block)
+        return lhs;
+    const Cow_Mystring keep{rhs};       // rhs may be lhs, or share its block
+    const std::size_t size = lhs.block ? lhs.block->size : 0;
+    lhs.make_unique(size + keep.block->size);
+    std::memcpy(lhs.block->chars() + size, keep.block->chars(), keep.block->size + 1);
+    lhs.block->size = size + keep.block->size;
+    return lhs;
+}
+
+Cow_Mystring operator*(const Cow_Mystring &lhs, int n) {
+    Cow_Mystring temp{lhs};
+    temp *= n;
+    return temp;
+}
+
+Cow_Mystring &operator*=(Cow_Mystring &lhs, int n) {
+    if (!lhs.block || n == 1)
+        return lhs;
+    if (n <= 0) {
+        lhs = Cow_Mystring{};
+        return lhs;
+    }
+    const std::size_t unit = lhs.block->size;
+    if (unit > std::numeric_limits<std::size_t>::max() / 2 / static_cast<std::size_t>(n))
+        throw std::length_error{"Cow_Mystring: repeated string too long"};
+    const std::size_t total = unit * static_cast<std::size_t>(n);
+    lhs.make_unique(total);
+    char *dest = lhs.block->chars();
+    for (std::size_t filled = unit; filled < total; ) {
+        const std::size_t chunk = std::min(filled, total - filled);
+        std::memcpy(dest + filled, dest, chunk);
+        filled += chunk;
+    }
+    dest[total] = '\0';
+    lhs.block->size = total;
+    return lhs;
+}
+
+Cow_Mystring &operator++(Cow_Mystring &obj) {
+    if (obj.block) {
+        obj.make_unique(obj.block->size);
+        to_upper_in_place(obj.block->chars(), obj.block->size);
+    }
+    return obj;
+}
+
+Cow_Mystring operator++(Cow_Mystring &obj, int) {
+    Cow_Mystring temp{obj};             // O(1): shares the old value
+    ++obj;                              // detaches obj, temp keeps the old bytes
+    return temp;
+}
+
+bool operator==(const Cow_Mystring &lhs, const Cow_Mystring &rhs) {
+    return lhs.block == rhs.block || static_cast<Mystring_view>(lhs) == static_cast<Mystring_view>(rhs);
+}
+
+bool operator!=(const Cow_Mystring &lhs, const Cow_Mystring &rhs) {
+    return !(lhs == rhs);
+}
+
+bool operator<(const Cow_Mystring &lhs, const Cow_Mystring &rhs) {
+    return static_cast<Mystring_view>(lhs) < static_cast<Mystring_view>(rhs);
+}
+
+std::ostream &operator<<(std::ostream &os, const Cow_Mystring &rhs) {
+    return os << static_cast<Mystring_view>(rhs);
+}
@@ -0,0 +1,71 @@
+// Cow_Mystring: opt-in copy-on-write string.
+//
+// Copies share one heap block guarded by an atomic reference count, so
+// copying (even a 1 MB value) is O(1). The first mutating operator on a
+// shared value (++, *=, +=) makes a private copy; until then every copy
+// reads the same bytes. Use it where values are copied far more often than
+// modified (pass-by-value APIs, containers of mostly-read strings), and
+// plain Mystring everywhere else.
+//
+// Sharing is thread-safe (the count is atomic); mutating ONE Cow_Mystring
+// object from several threads at once is not, just as with Mystring.
+// --------------------------------------------------------------
+#ifndef _MYSTRING_COW_H_
+#define _MYSTRING_COW_H_
+
+#include <atomic>
+#include <cstddef>
+#include <iosfwd>
+#include "Mystring_view.h"
+
+class Mystring;
+
+class Cow_Mystring
+{
+    friend Cow_Mystring operator+(const Cow_Mystring &lhs, const Cow_Mystring &rhs);
+    friend Cow_Mystring operator-(const Cow_Mystring &obj);                // lowercase copy
+    friend Cow_Mystring operator*(const Cow_Mystring &lhs, int n);
+    friend Cow_Mystring &operator+=(Cow_Mystring &lhs, const Cow_Mystring &rhs);
+    friend Cow_Mystring &operator*=(Cow_Mystring &lhs, int n);
+    friend Cow_Mystring &operator++(Cow_Mystring &obj);                    // uppercase in place
+    friend Cow_Mystring operator++(Cow_Mystring &obj, int);
+    friend bool operator==(const Cow_Mystring &lhs, const Cow_Mystring &rhs);
+    friend bool operator!=(const Cow_Mystring &lhs, const Cow_Mystring &rhs);
+    friend bool operator<(const Cow_Mystring &lhs, const Cow_Mystring &rhs);
+    friend std::ostream &operator<<(std::ostream &os, const Cow_Mystring &rhs);
+
+private:
+    // Shared heap block: header followed by capacity + 1 characters
+    struct Block {
+        std::atomic<std::size_t> refs;
+        std::size_t size;
+        std::size_t capacity;
+        char *chars() { return reinterpret_cast<char *>(this + 1); }
+    };
+
+    Block *block;           // nullptr means the empty string
+
+    static Block *allocate(std::size_t capacity);
+    static void release(Block *b);
+    void make_unique(std::size_t min_capacity);   // private copy with room for min_capacity
+
+public:
+    Cow_Mystring();
+    Cow_Mystring(const char *s);
+    explicit Cow_Mystring(Mystring_view v);
+    explicit Cow_Mystring(const Mystring &s);
+    Cow_Mystring(const Cow_Mystring &source);      // O(1): shares the block
+    Cow_Mystring(Cow_Mystring &&source) noexcept;
+    ~Cow_Mystring();
+
+    Cow_Mystring &operator=(const Cow_Mystring &rhs);
+    Cow_Mystring &operator=(Cow_Mystring &&rhs) noexcept;
+
+    int         get_length() const;
+    const char *get_str() const;
+    std::size_t use_count() const;                 // objects sharing the block (0 when empty)
+    operator Mystring_view() const;
+    Mystring    to_mystring() const;               // owned, unshared copy
+};
+
+#endif // _MYSTRING_COW_H_
@@ -0,0 +1,177 @@
+// Implements the memory-mapped file and its lazy record splitting.
+// --------------------------------------------------------------
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include "Mystring.h"
+#include "Mystring_file.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ===== Mystring_records =====
+
+Mystring_records::iterator::iterator(Mystring_view text, char delim)
+    : next{text.data()}, end{text.data() + text.size()}, current{}, delim{delim}, done{false} {
+    advance();
+}
+
+void Mystring_records::iterator::advance() {
+    if (next == end) {
+        done = true;
+        return;
+    }
+    const void *hit = std::memchr(next, delim, static_cast<std::size_t>(end - next));
+    const char *stop = hit ? static_cast<const char *>(hit) : end;
+    std::size_t n = static_cast<std::size_t>(stop - next);
+    if (delim == '\n' && n != 0 && next[n - 1] == '\r')
+        --n;
+    current = Mystring_view{next, n};
+    next = hit ? stop + 1 : end;
+}
+
+// ===== Mystring_file =====
+
+#ifdef _WIN32
+
+Mystring_file::Mystring_file(const char *path)
+    : base{nullptr}, length{0}, file_handle{INVALID_HANDLE_VALUE}, mapping_handle{nullptr} {
+    file_handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file_handle == INVALID_HANDLE_VALUE)
+        throw std::runtime_error{std::string{"Mystring_file: cannot open "} + path};
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file_handle, &file_size)) {
+        close();
+        throw std::runtime_error{std::string{"Mystring_file: cannot stat "} + path};
+    }
+    length = static_cast<std::size_t>(file_size.QuadPart);
+    if (length == 0)
+        return;                                 // empty files cannot be mapped
+    mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_handle)
+        base = static_cast<const char *>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+    if (!base) {
+        close();
+        throw std::runtime_error{std::string{"Mystring_file: cannot map "} + path};
+    }
+}
+
+void Mystring_file::close() {
+    if (base)
+        UnmapViewOfFile(base);
+    if (mapping_handle)
+        CloseHandle(mapping_handle);
+    if (file_handle != INVALID_HANDLE_VALUE)
+        CloseHandle(file_handle);
+    base = nullptr;
+    length = 0;
+    mapping_handle = nullptr;
+    file_handle = INVALID_HANDLE_VALUE;
+}
+
+Mystring_file::Mystring_file(Mystring_file &&source) noexcept
+    : base{source.base}, length{source.length},
+      file_handle{source.file_handle}, mapping_handle{source.mapping_handle} {
+    source.base = nullptr;
+    source.length = 0;
+    source.file_handle = INVALID_HANDLE_VALUE;
+    source.mapping_handle = nullptr;
+}
+
+Mystring_file &Mystring_file::operator=(Mystring_file &&rhs) noexcept {
+    if (this != &rhs) {
+        close();
+        base = rhs.base;
+        length = rhs.length;
+        file_handle = rhs.file_handle;
+        mapping_handle = rhs.mapping_handle;
+        rhs.base = nullptr;
+        rhs.length = 0;
+        rhs.file_handle = INVALID_HANDLE_VALUE;
+        rhs.mapping_handle = nullptr;
+    }
+    return *this;
+}
+
+#else
+
+Mystring_file::Mystring_file(const char *path)
+    : base{nullptr}, length{0}, fd{-1} {
+    fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error{std::string{"Mystring_file: cannot open "} + path + ": " + std::strerror(errno)};
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        close();
+        throw std::runtime_error{std::string{"Mystring_file: cannot stat "} + path};
+    }
+    length = static_cast<std::size_t>(info.st_size);
+    if (length == 0)
+        return;                                 // empty files cannot be mapped
+    void *mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) {
+        close();
+        throw std::runtime_error{std::string{"Mystring_file: cannot map "} + path};
+    }
+    base = static_cast<const char *>(mapped);
+    ::madvise(mapped, length, MADV_SEQUENTIAL); // aggressive read-ahead for scans
+}
+
+void Mystring_file::close() {
+    if (base)
+        ::munmap(const_cast<char *>(base), length);
+    if (fd >= 0)
+        ::close(fd);
+    base = nullptr;
+    length = 0;
+    fd = -1;
+}
+
+Mystring_file::Mystring_file(Mystring_file &&source) noexcept
+    : base{source.base}, length{source.length}, fd{source.fd} {
+    source.base = nullptr;
+    source.length = 0;
+    source.fd = -1;
+}
+
+Mystring_file &Mystring_file::operator=(Mystring_file &&rhs) noexcept {
+    if (this != &rhs) {
+        close();
+        base = rhs.base;
+        length = rhs.length;
+        fd = rhs.fd;
+        rhs.base = nullptr;
+        rhs.length = 0;
+        rhs.fd = -1;
+    }
+    return *this;
+}
+
+#endif
+
+Mystring_file::~Mystring_file() {
+    close();
+}
+
+Mystring Mystring_file::materialize(Mystring_view slice) const {
+    if (slice.empty())
+        return Mystring{};
+    const char *first = slice.data();
+    if (!base || first < base || slice.size() > length || first > base + (length - slice.size()))
+        throw std::out_of_range{"Mystring_file::materialize: slice is not part of this file"};
+    return Mystring{slice};
+}
@@ -0,0 +1,116 @@
+// Mystring_file: a read-only memory-mapped file, read as Mystring_view slices.
+//
+// Opening maps the file (mmap on POSIX, MapViewOfFile on Windows) without
+// reading it, so even a multi-GB corpus opens instantly; the OS pages data
+// in as it is touched. lines() and records() split lazily, one memchr per
+// record, and hand out views into the mapping: nothing is copied until
+// materialize() is called on a slice that must outlive the file.
+//
+//   Mystring_file corpus{"corpus.txt"};
+//   for (Mystring_view line : corpus.lines()) {        // '\n' or "\r\n"
+//       if (line.starts_with("ERROR"))
+//           errors.push_back(corpus.materialize(line)); // owned copy
+//   }
+//
+// Views are valid only while the Mystring_file is alive. The file must not
+// be truncated by another process while it is mapped.
+// --------------------------------------------------------------
+#ifndef _MYSTRING_FILE_H_
+#define _MYSTRING_FILE_H_
+
+#include <cstddef>
+#include <iterator>
+#include "Mystring_view.h"
+
+class Mystring;
+
+// Lazy sequence of the delim-separated records of a text. A final record
+// without a trailing delimiter is included; a trailing delimiter does not
+// produce an empty last record. Line mode ('\n') also drops a '\r' before it.
+class Mystring_records
+{
+private:
+    Mystring_view text;
+    char delim;
+
+public:
+    class iterator
+    {
+    private:
+        const char *next;           // start of the record after current
+        const char *end;
+        Mystring_view current;
+        char delim;
+        bool done;
+
+        void advance();
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Mystring_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Mystring_view *;
+        using reference = const Mystring_view &;
+
+        iterator() : next{nullptr}, end{nullptr}, current{}, delim{'\n'}, done{true} {}
+        iterator(Mystring_view text, char delim);
+
+        reference operator*() const { return current; }
+        pointer operator->() const { return &current; }
+        iterator &operator++() { advance(); return *this; }
+        iterator operator++(int) { iterator old{*this}; advance(); return old; }
+        bool operator==(const iterator &rhs) const { return done == rhs.done && (done || next == rhs.next); }
+        bool operator!=(const iterator &rhs) const { return !(*this == rhs); }
+    };
+
+    Mystring_records(Mystring_view text, char delim) : text{text}, delim{delim} {}
+
+    iterator begin() const { return iterator{text, delim}; }
+    iterator end() const { return iterator{}; }
+};
+
+class Mystring_file
+{
+private:
+    const char *base;       // start of the mapping (nullptr for an empty file)
+    std::size_t length;
+#ifdef _WIN32
+    void *file_handle;
+    void *mapping_handle;
+#else
+    int fd;
+#endif
+
+    void close();
+
+public:
+    explicit Mystring_file(const char *path);   // throws std::runtime_error
+    Mystring_file(Mystring_file &&source) noexcept;
+    Mystring_file &operator=(Mystring_file &&rhs) noexcept;
+    Mystring_file(const Mystring_file &) = delete;
+    Mystring_file &operator=(const Mystring_file &) = delete;
+    ~Mystring_file();
+
+    std::size_t      size() const { return length; }
+    Mystring_view    view() const { return Mystring_view{base ? base : "", length}; }
+    Mystring_records lines() const { return Mystring_records{view(), '\n'}; }
+    Mystring_records records(char delim) const { return Mystring_records{view(), delim}; }
+
+    // Owned copy of a slice of this file (throws std::out_of_range if the
+    // slice does not point into the mapping)
+    Mystring materialize(Mystring_view slice) const;
+};
+
+// Open path and call fn(Mystring_view) for every line; returns the line count
+template <typename Fn>
+std::size_t mapped_lines(const char *path, Fn fn) {
+    const Mystring_file file{path};
+    std::size_t count = 0;
+    for (Mystring_view line : file.lines()) {
+        fn(line);
+        ++count;
+    }
+    return count;
+}
+
+#endif // _MYSTRING_FILE_H_
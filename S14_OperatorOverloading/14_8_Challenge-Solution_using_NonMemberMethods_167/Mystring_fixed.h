@@ -0,0 +1,102 @@
+// Compile-time strings: Fixed_Mystring<N> and the _ms literal.
+//
+// Fixed_Mystring<N> holds up to N characters in an inline array and is
+// constexpr-constructible, so constants and lookup tables are built by the
+// compiler and live in read-only data: no allocation, no copy, no startup
+// code.
+//
+//   constexpr auto name = Fixed_Mystring{"Frank"};       // N deduced: 5
+//   constexpr Fixed_Mystring<7> days[] = {"Mon", "Tue", "Wed"};
+//   static_assert(days[1] == Fixed_Mystring{"Tue"});
+//   Mystring owned{name};                                // one memcpy, no strlen
+//
+// (Prefer "constexpr auto x = Fixed_Mystring{...}" over deducing N in the
+// declaration itself: GCC 12 puts the latter in writable .data.)
+//
+// The _ms literal gives a constexpr Mystring_view of the literal itself
+// (pointer + length of characters the compiler already placed in
+// read-only data), the cheapest way to hand a constant to Mystring:
+//
+//   using namespace mystring_literals;
+//   Mystring s{"Frank"_ms};       // length known at compile time, no strlen
+// --------------------------------------------------------------
+#ifndef _MYSTRING_FIXED_H_
+#define _MYSTRING_FIXED_H_
+
+#include <cstddef>
+#include "Mystring.h"
+#include "Mystring_view.h"
+
+template <std::size_t N>
+class Fixed_Mystring
+{
+private:
+    char chars[N + 1];          // characters + '\0'
+    std::size_t length;
+
+public:
+    constexpr Fixed_Mystring() : chars{}, length{0} {}
+
+    // From a string literal, or any char array holding a terminated string:
+    // the length runs to the first '\0' (the last element is taken as the
+    // terminator), so char buf[10] = "ab" gives length 2. The array itself
+    // must fit in the capacity.
+    template <std::size_t M>
+    constexpr Fixed_Mystring(const char (&s)[M]) : chars{}, length{0} {
+        static_assert(M - 1 <= N, "Fixed_Mystring: array longer than the capacity");
+        while (length < M - 1 && s[length] != '\0') {
+            chars[length] = s[length];
+            ++length;
+        }
+    }
+
+    constexpr int         get_length() const { return static_cast<int>(length); }
+    constexpr std::size_t get_capacity() const { return N; }
+    constexpr const char *get_str() const { return chars; }
+    constexpr Mystring_view view() const { return Mystring_view{chars, length}; }
+    constexpr operator Mystring_view() const { return view(); }
+
+    Mystring to_mystring() const { return Mystring{view()}; }
+};
+
+// Fixed_Mystring{"Frank"} deduces exactly the literal's length
+template <std::size_t M>
+Fixed_Mystring(const char (&)[M]) -> Fixed_Mystring<M - 1>;
+
+// Comparisons usable in constant expressions (e.g. static_assert, constexpr lookups)
+template <std::size_t N, std::size_t M>
+constexpr bool operator==(const Fixed_Mystring<N> &lhs, const Fixed_Mystring<M> &rhs) {
+    if (lhs.get_length() != rhs.get_length())
+        return false;
+    for (int i = 0; i < lhs.get_length(); ++i)
+        if (lhs.get_str()[i] != rhs.get_str()[i])
+            return false;
+    return true;
+}
+
+template <std::size_t N, std::size_t M>
+constexpr bool operator!=(const Fixed_Mystring<N> &lhs, const Fixed_Mystring<M> &rhs) {
+    return !(lhs == rhs);
+}
+
+template <std::size_t N, std::size_t M>
+constexpr bool operator<(const Fixed_Mystring<N> &lhs, const Fixed_Mystring<M> &rhs) {
+    const int common = lhs.get_length() < rhs.get_length() ? lhs.get_length() : rhs.get_length();
+    for (int i = 0; i < common; ++i) {
+        const auto a = static_cast<unsigned char>(lhs.get_str()[i]);
+        const auto b = static_cast<unsigned char>(rhs.get_str()[i]);
+        if (a != b)
+            return a < b;
+    }
+    return lhs.get_length() < rhs.get_length();
+}
+
+namespace mystring_literals {
+
+constexpr Mystring_view operator""_ms(const char *s, std::size_t length) {
+    return Mystring_view{s, length};
+}
+
+} // namespace mystring_literals
+
+#endif // _MYSTRING_FIXED_H_
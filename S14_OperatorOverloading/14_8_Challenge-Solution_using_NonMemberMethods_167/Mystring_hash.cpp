@@ -0,0 +1,126 @@
+// Implements the wyhash-style byte hash and Hashed_Mystring.
+// --------------------------------------------------------------
+#include <cstring>
+#include "Mystring_hash.h"
+
+namespace {
+
+constexpr std::uint64_t secret[4] {0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+                                   0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull};
+
+// Unaligned little-endian-agnostic loads (the hash only needs to be stable per build)
+std::uint64_t read8(const unsigned char *p) {
+    std::uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+}
+
+std::uint64_t read4(const unsigned char *p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+// 1..3 bytes: first, middle and last byte
+std::uint64_t read3(const unsigned char *p, std::size_t k) {
+    return (std::uint64_t{p[0]} << 16) | (std::uint64_t{p[k >> 1]} << 8) | p[k - 1];
+}
+
+// 64x64 -> 128-bit multiply; returns low and high halves in a and b
+void multiply(std::uint64_t &a, std::uint64_t &b) {
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+    a = static_cast<std::uint64_t>(r);
+    b = static_cast<std::uint64_t>(r >> 64);
+#else
+    const std::uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<std::uint32_t>(a),
+                        lb = static_cast<std::uint32_t>(b);
+    const std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    const std::uint64_t t = rl + (rm0 << 32);
+    std::uint64_t carry = t < rl;
+    const std::uint64_t lo = t + (rm1 << 32);
+    carry += lo < t;
+    a = lo;
+    b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
+
+std::uint64_t mix(std::uint64_t a, std::uint64_t b) {
+    multiply(a, b);
+    return a ^ b;
+}
+
+} // namespace
+
+std::uint64_t hash_bytes(const void *data, std::size_t length, std::uint64_t seed) {
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    seed ^= mix(seed ^ secret[0], secret[1]);
+    std::uint64_t a, b;
+
+    if (length <= 16) {
+        if (length >= 4) {
+            const std::size_t shift = (length >> 3) << 2;
+            a = (read4(p) << 32) | read4(p + shift);
+            b = (read4(p + length - 4) << 32) | read4(p + length - 4 - shift);
+        } else if (length > 0) {
+            a = read3(p, length);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        std::size_t i = length;
+        if (i > 48) {
+            std::uint64_t seed1 = seed, seed2 = seed;
+            do {
+                seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+                seed1 = mix(read8(p + 16) ^ secret[2], read8(p + 24) ^ seed1);
+                seed2 = mix(read8(p + 32) ^ secret[3], read8(p + 40) ^ seed2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while (i > 16) {
+            seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = read8(p + i - 16);
+        b = read8(p + i - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    multiply(a, b);
+    return mix(a ^ secret[0] ^ length, b ^ secret[1]);
+}
+
+// ===== Hashed_Mystring =====
+
+Hashed_Mystring::Hashed_Mystring(const char *s)
+    : value{s}, cached_hash{0}, has_hash{false} {
+}
+
+Hashed_Mystring::Hashed_Mystring(Mystring s)
+    : value{std::move(s)}, cached_hash{0}, has_hash{false} {
+}
+
+std::size_t Hashed_Mystring::hash() const {
+    if (!has_hash) {
+        cached_hash = value.hash();
+        has_hash = true;
+    }
+    return cached_hash;
+}
+
+// Cached hashes that differ prove inequality without touching the bytes
+bool operator==(const Hashed_Mystring &lhs, const Hashed_Mystring &rhs) {
+    if (lhs.has_hash && rhs.has_hash && lhs.cached_hash != rhs.cached_hash)
+        return false;
+    return lhs.value == rhs.value;
+}
+
+bool operator!=(const Hashed_Mystring &lhs, const Hashed_Mystring &rhs) {
+    return !(lhs == rhs);
+}
@@ -0,0 +1,50 @@
+// Hashing support for Mystring.
+//
+//   - hash_bytes(): fast non-cryptographic 64-bit hash (wyhash-style:
+//     wide 64x64->128 multiply-mix, 16/48-byte steps). Not for security use.
+//   - std::hash<Mystring> (declared in Mystring.h) calls Mystring::hash(),
+//     so Mystring can key std::unordered_map / std::unordered_set.
+//     std::hash<Mystring_view> (Mystring_view.h) produces the same values.
+//   - Hashed_Mystring: optional cached-hash key. The hash is computed on
+//     first use and reused for every later lookup and rehash. The value is
+//     read-only through the wrapper, so the cache can never go stale.
+//     (The lazy cache is not synchronized; do not share one object across
+//     threads before its hash has been computed.)
+// --------------------------------------------------------------
+#ifndef _MYSTRING_HASH_H_
+#define _MYSTRING_HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include "Mystring.h"
+
+std::uint64_t hash_bytes(const void *data, std::size_t length, std::uint64_t seed = 0);
+
+class Hashed_Mystring
+{
+    friend bool operator==(const Hashed_Mystring &lhs, const Hashed_Mystring &rhs);
+    friend bool operator!=(const Hashed_Mystring &lhs, const Hashed_Mystring &rhs);
+
+private:
+    Mystring value;
+    mutable std::size_t cached_hash;   // valid only when has_hash is true
+    mutable bool has_hash;
+
+public:
+    Hashed_Mystring(const char *s = "");
+    Hashed_Mystring(Mystring s);
+
+    const Mystring &get() const { return value; }
+    std::size_t hash() const;          // computed once, then cached
+};
+
+namespace std {
+template <>
+struct hash<Hashed_Mystring> {
+    std::size_t operator()(const Hashed_Mystring &s) const { return s.hash(); }
+};
+} // namespace std
+
+#endif // _MYSTRING_HASH_H_
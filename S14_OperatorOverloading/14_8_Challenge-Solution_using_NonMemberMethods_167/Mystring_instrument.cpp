@@ -0,0 +1,115 @@
+// Implements the per-call-site counters (only with -DMYSTRING_INSTRUMENT).
+// --------------------------------------------------------------
+#include "Mystring_instrument.h"
+
+#ifdef MYSTRING_INSTRUMENT
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace mystring_instrument {
+
+namespace {
+
+struct Counters {
+    std::size_t constructions {0};
+    std::size_t copies {0};
+    std::size_t moves {0};
+    std::size_t allocations {0};
+    std::size_t bytes {0};
+};
+
+// A site is identified by file, line and function (column differs per
+// expression on one line and would only split the rows)
+struct Site_key {
+    std::string file;
+    unsigned line;
+    std::string function;
+    bool operator<(const Site_key &rhs) const {
+        return std::tie(file, line, function) < std::tie(rhs.file, rhs.line, rhs.function);
+    }
+};
+
+std::mutex table_mutex;
+std::map<Site_key, Counters> &table() {
+    static std::map<Site_key, Counters> sites;
+    return sites;
+}
+
+thread_local const std::source_location *current_scope {nullptr};
+
+std::atomic<std::size_t> dropped {0};      // samples lost to a failed allocation
+
+const char *base_name(const char *path) {
+    const char *name = path;
+    for (const char *p = path; *p; ++p)
+        if (*p == '/' || *p == '\\')
+            name = p + 1;
+    return name;
+}
+
+} // namespace
+
+Scope::Scope(const std::source_location &s) noexcept
+    : previous{current_scope}, site{s} {
+    current_scope = &site;
+}
+
+Scope::~Scope() {
+    current_scope = previous;
+}
+
+void record(const std::source_location &site, Event event, std::size_t bytes) noexcept {
+    const std::source_location &where = current_scope ? *current_scope : site;
+    try {
+        const std::lock_guard<std::mutex> lock{table_mutex};
+        Counters &c = table()[Site_key{base_name(where.file_name()), where.line(), where.function_name()}];
+        switch (event) {
+        case Event::construct: ++c.constructions; break;
+        case Event::copy:      ++c.copies; break;
+        case Event::move:      ++c.moves; break;
+        case Event::allocate:  ++c.allocations; c.bytes += bytes; break;
+        }
+    } catch (...) {
+        // a new site's key or map node could not be allocated
+        dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void report(std::ostream &os) {
+    std::vector<std::pair<Site_key, Counters>> rows;
+    {
+        const std::lock_guard<std::mutex> lock{table_mutex};
+        rows.assign(table().begin(), table().end());
+    }
+    std::sort(rows.begin(), rows.end(), [](const auto &a, const auto &b) {
+        return std::tie(b.second.copies, b.second.bytes) < std::tie(a.second.copies, a.second.bytes);
+    });
+
+    os << std::right << std::setw(8) << "ctors" << std::setw(8) << "copies" << std::setw(8) << "moves"
+       << std::setw(8) << "allocs" << std::setw(10) << "bytes" << "  site\n";
+    for (const auto &[key, c] : rows) {
+        os << std::setw(8) << c.constructions << std::setw(8) << c.copies << std::setw(8) << c.moves
+           << std::setw(8) << c.allocations << std::setw(10) << c.bytes
+           << "  " << key.file << ':' << key.line << "  " << key.function << '\n';
+    }
+    if (const std::size_t lost = dropped.load(std::memory_order_relaxed))
+        os << lost << " events dropped (out of memory while recording)\n";
+}
+
+void reset() {
+    const std::lock_guard<std::mutex> lock{table_mutex};
+    table().clear();
+    dropped.store(0, std::memory_order_relaxed);
+}
+
+} // namespace mystring_instrument
+
+#endif // MYSTRING_INSTRUMENT
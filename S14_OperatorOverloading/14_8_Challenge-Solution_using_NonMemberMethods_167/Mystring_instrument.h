@@ -0,0 +1,87 @@
+// Mystring instrumentation: per-call-site construction/copy/move/allocation
+// counters, enabled at compile time.
+//
+// Build with -DMYSTRING_INSTRUMENT -std=c++20 (it needs std::source_location):
+//   - every public constructor takes a defaulted std::source_location, so
+//     constructions, deep copies and moves are charged to the line that
+//     created the object (your code, or e.g. std::vector's construct call);
+//   - heap allocations are charged to the constructor's caller, or to the
+//     Mystring member that allocated (reserve, assign, ...);
+//   - assignment operators cannot take extra parameters, so copy/move
+//     assignments are charged to operator= itself. Put
+//     MYSTRING_INSTRUMENT_SCOPE(); at the top of a block to charge every
+//     event inside it (on this thread) to that line instead.
+//
+//   mystring_instrument::report(std::cout);   // one row per call site
+//
+// Without MYSTRING_INSTRUMENT every macro below expands to nothing: the
+// constructors keep their plain signatures and the hot path is unchanged.
+// --------------------------------------------------------------
+#ifndef _MYSTRING_INSTRUMENT_H_
+#define _MYSTRING_INSTRUMENT_H_
+
+#ifdef MYSTRING_INSTRUMENT
+
+#if __cplusplus < 202002L
+#error "MYSTRING_INSTRUMENT needs C++20 for std::source_location (build with -std=c++20)"
+#endif
+
+#include <cstddef>
+#include <iosfwd>
+#include <source_location>
+
+namespace mystring_instrument {
+
+enum class Event { construct, copy, move, allocate };
+
+// Charge one event to the innermost active Scope on this thread, else to site.
+// Never throws, so noexcept members (the move constructor) can record: if
+// the table cannot grow, the sample is dropped and counted in the report.
+void record(const std::source_location &site, Event event, std::size_t bytes = 0) noexcept;
+
+// Print one row per call site, most deep copies first
+void report(std::ostream &os);
+
+// Forget everything recorded so far
+void reset();
+
+// While alive, events on this thread are charged to site (scopes nest)
+class Scope
+{
+private:
+    const std::source_location *previous;
+    std::source_location site;
+public:
+    explicit Scope(const std::source_location &site) noexcept;
+    ~Scope();
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+};
+
+} // namespace mystring_instrument
+
+// Trailing defaulted parameter for declarations, plain one for definitions
+#define MYSTRING_SITE     , std::source_location site = std::source_location::current()
+#define MYSTRING_SITE_DEF , std::source_location site
+#define MYSTRING_SITE_ARG , site
+#define MYSTRING_RECORD(event, bytes) \
+    mystring_instrument::record(site, mystring_instrument::Event::event, bytes)
+#define MYSTRING_RECORD_HERE(event) \
+    mystring_instrument::record(std::source_location::current(), mystring_instrument::Event::event)
+#define MYSTRING_SITE_SCOPE() const mystring_instrument::Scope mystring_site_scope_{site}
+#define MYSTRING_INSTRUMENT_SCOPE() \
+    const mystring_instrument::Scope mystring_instrument_scope_{std::source_location::current()}
+
+#else
+
+#define MYSTRING_SITE
+#define MYSTRING_SITE_DEF
+#define MYSTRING_SITE_ARG
+#define MYSTRING_RECORD(event, bytes)
+#define MYSTRING_RECORD_HERE(event)
+#define MYSTRING_SITE_SCOPE()
+#define MYSTRING_INSTRUMENT_SCOPE()
+
+#endif // MYSTRING_INSTRUMENT
+
+#endif // _MYSTRING_INSTRUMENT_H_
@@ -0,0 +1,81 @@
+// Implements chunked stream tokenizing.
+// --------------------------------------------------------------
+#include <cstring>
+#include "Mystring.h"
+#include "Mystring_io.h"
+
+namespace {
+
+// ASCII whitespace, same set as the "C" locale's isspace
+bool is_space(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+} // namespace
+
+Token_reader::Token_reader(std::istream &in, std::size_t chunk_size)
+    : in{in}, buffer(chunk_size < 16 ? 16 : chunk_size), pos{0}, end{0}, eof{false} {
+}
+
+// Move buffer[keep_from..end) to the front, grow if it fills the buffer,
+// then read what the stream buffer has, up to what fits after it. A short
+// read is not the end (pipes and custom buffers return partial reads);
+// only a read that returns nothing is.
+void Token_reader::refill(std::size_t keep_from) {
+    const std::size_t kept = end - keep_from;
+    if (kept != 0 && keep_from != 0)
+        std::memmove(buffer.data(), buffer.data() + keep_from, kept);
+    if (kept == buffer.size())
+        buffer.resize(buffer.size() * 2);       // token longer than a chunk
+    pos -= keep_from;
+    end = kept;
+
+    const std::streamsize want = static_cast<std::streamsize>(buffer.size() - end);
+    const std::streamsize got = in.rdbuf()->sgetn(buffer.data() + end, want);
+    end += static_cast<std::size_t>(got);
+    if (got == 0) {
+        eof = true;
+        in.setstate(std::ios_base::eofbit);
+    }
+}
+
+bool Token_reader::next(Mystring_view &token) {
+    // Skip whitespace, refilling as needed
+    for (;;) {
+        while (pos < end && is_space(buffer[pos]))
+            ++pos;
+        if (pos < end)
+            break;
+        if (eof)
+            return false;
+        refill(end);
+    }
+
+    // Scan the token; if it runs into the end of the data, keep it and refill
+    std::size_t start = pos;
+    for (;;) {
+        while (pos < end && !is_space(buffer[pos]))
+            ++pos;
+        if (pos < end || eof)
+            break;
+        refill(start);
+        start = 0;
+    }
+    token = Mystring_view{buffer.data() + start, pos - start};
+    return true;
+}
+
+std::size_t read_tokens(std::istream &in, std::vector<Mystring> &out) {
+    Token_reader reader{in};
+    Mystring_view token;
+    std::size_t count = 0;
+    while (reader.next(token)) {
+        if (count < out.size())
+            out[count].assign(token);           // reuse the element's buffer
+        else
+            out.emplace_back(token);
+        ++count;
+    }
+    out.erase(out.begin() + static_cast<std::ptrdiff_t>(count), out.end());
+    return count;
+}
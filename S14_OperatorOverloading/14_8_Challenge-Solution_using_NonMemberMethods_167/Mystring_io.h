@@ -0,0 +1,46 @@
+// Bulk, allocation-free tokenizing of streams into Mystring.
+//
+// Token_reader pulls large chunks from the stream buffer (sgetn) and
+// splits them in place on ASCII whitespace. next() hands back a
+// Mystring_view into its chunk, valid until the following next() call.
+// A token that straddles two chunks is moved to the front of the buffer
+// before the refill, so every view is contiguous.
+//
+//   Token_reader reader{file};
+//   Mystring_view token;
+//   while (reader.next(token)) { ... }       // no per-token allocation
+//
+// read_tokens() collects every token into a vector, assigning into the
+// existing elements so their capacity is reused across calls.
+// --------------------------------------------------------------
+#ifndef _MYSTRING_IO_H_
+#define _MYSTRING_IO_H_
+
+#include <cstddef>
+#include <istream>
+#include <vector>
+#include "Mystring_view.h"
+
+class Mystring;
+
+class Token_reader
+{
+private:
+    std::istream &in;
+    std::vector<char> buffer;
+    std::size_t pos;        // next unread byte in buffer
+    std::size_t end;        // bytes of valid data in buffer
+    bool eof;
+
+    void refill(std::size_t keep_from);         // buffer[keep_from..end) moves to the front
+
+public:
+    explicit Token_reader(std::istream &in, std::size_t chunk_size = 256 * 1024);
+
+    bool next(Mystring_view &token);            // false when the stream is exhausted
+};
+
+// Replaces the contents of out with all tokens of in; returns the token count
+std::size_t read_tokens(std::istream &in, std::vector<Mystring> &out);
+
+#endif // _MYSTRING_IO_H_
@@ -0,0 +1,97 @@
+// Implements the single-threaded and striped interning pools.
+// --------------------------------------------------------------
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include "Mystring_pool.h"
+
+// ===== Mystring_pool =====
+
+Mystring_pool::Mystring_pool()
+    : slots(64, Slot{nullptr, 0, 0}), count{0}, cursor{nullptr}, remaining{0}, bytes{0} {
+}
+
+// Copy s (plus '\0') into block storage that never moves
+const char *Mystring_pool::store(Mystring_view s) {
+    const std::size_t need = s.size() + 1;
+    if (need > remaining) {
+        const std::size_t capacity = std::max(block_size, need);
+        blocks.push_back(std::make_unique<char[]>(capacity));
+        cursor = blocks.back().get();
+        remaining = capacity;
+    }
+    char *copy = cursor;
+    std::memcpy(copy, s.data(), s.size());
+    copy[s.size()] = '\0';
+    cursor += need;
+    remaining -= need;
+    bytes += need;
+    return copy;
+}
+
+// Double the table and reinsert every slot (hashes are cached, no rehashing)
+void Mystring_pool::grow() {
+    std::vector<Slot> old(slots.size() * 2, Slot{nullptr, 0, 0});
+    old.swap(slots);
+    const std::size_t mask = slots.size() - 1;
+    for (const Slot &slot : old) {
+        if (!slot.ptr)
+            continue;
+        std::size_t i = slot.hash & mask;
+        while (slots[i].ptr)
+            i = (i + 1) & mask;
+        slots[i] = slot;
+    }
+}
+
+Interned Mystring_pool::intern(Mystring_view s) {
+    return intern(s, std::hash<Mystring_view>{}(s));
+}
+
+Interned Mystring_pool::intern(Mystring_view s, std::size_t hash) {
+    if (s.empty())
+        return Interned{};
+    const std::size_t mask = slots.size() - 1;
+    std::size_t i = hash & mask;
+    while (slots[i].ptr) {
+        const Slot &slot = slots[i];
+        if (slot.hash == hash && slot.len == s.size() && std::memcmp(slot.ptr, s.data(), s.size()) == 0)
+            return Interned{slot.ptr, slot.len};
+        i = (i + 1) & mask;
+    }
+
+    const char *copy = store(s);
+    slots[i] = Slot{copy, s.size(), hash};
+    if (++count * 2 > slots.size())
+        grow();
+    return Interned{copy, s.size()};
+}
+
+// ===== Concurrent_Mystring_pool =====
+
+Concurrent_Mystring_pool::Concurrent_Mystring_pool()
+    : stripes{std::make_unique<Stripe[]>(stripe_count)} {
+}
+
+Interned Concurrent_Mystring_pool::intern(Mystring_view s) {
+    // Hash once, outside the lock. Top bits choose the stripe; the
+    // sub-pool's table indexes with the low bits.
+    const std::size_t h = std::hash<Mystring_view>{}(s);
+    Stripe &stripe = stripes[h >> (std::numeric_limits<std::size_t>::digits - stripe_bits)];
+    std::lock_guard<std::mutex> guard{stripe.lock};
+    return stripe.pool.intern(s, h);
+}
+
+std::size_t Concurrent_Mystring_pool::size() const {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < stripe_count; ++i)
+        total += stripes[i].pool.size();
+    return total;
+}
+
+std::size_t Concurrent_Mystring_pool::bytes_used() const {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < stripe_count; ++i)
+        total += stripes[i].pool.bytes_used();
+    return total;
+}
@@ -0,0 +1,116 @@
+// String interning for Mystring.
+//
+// A pool keeps ONE immutable, null-terminated copy of each distinct string.
+// intern() returns an Interned handle to that copy, so millions of equal
+// values share the same bytes and compare with a single pointer check.
+//
+//   Mystring_pool pool;
+//   Interned a = pool.intern("alpha");
+//   Interned b = pool.intern(Mystring{"alpha"});
+//   a == b;                   // pointer compare
+//
+// Handles stay valid for the lifetime of the pool that produced them;
+// handles from different pools must not be compared. The exception is the
+// empty string: it is never stored, every pool returns the same sentinel,
+// and a default-constructed Interned{} is that sentinel too.
+//
+// Concurrent_Mystring_pool is the thread-safe variant: the hash picks one of
+// a fixed number of stripes, each with its own mutex and sub-pool, so threads
+// interning different strings rarely contend.
+// --------------------------------------------------------------
+#ifndef _MYSTRING_POOL_H_
+#define _MYSTRING_POOL_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Mystring_view.h"
+
+class Interned
+{
+    friend bool operator==(Interned lhs, Interned rhs) { return lhs.ptr == rhs.ptr; }
+    friend bool operator!=(Interned lhs, Interned rhs) { return lhs.ptr != rhs.ptr; }
+    friend class Mystring_pool;
+
+private:
+    static constexpr char empty[1] {};    // the one address of every empty handle
+
+    const char *ptr;
+    std::size_t len;
+
+    Interned(const char *p, std::size_t n) : ptr{p}, len{n} {}
+
+public:
+    Interned() : ptr{empty}, len{0} {}
+
+    const char *get_str() const { return ptr; }
+    std::size_t size() const { return len; }
+    operator Mystring_view() const { return Mystring_view{get_str(), len}; }
+};
+
+class Mystring_pool
+{
+private:
+    // Open-addressing table (linear probing, power-of-two size, <= 50% full)
+    struct Slot {
+        const char *ptr;      // nullptr marks an empty slot
+        std::size_t len;
+        std::size_t hash;
+    };
+
+    static constexpr std::size_t block_size = 64 * 1024;
+
+    std::vector<Slot> slots;
+    std::size_t count;
+    std::vector<std::unique_ptr<char[]>> blocks;   // stable storage for the strings
+    char *cursor;          // next free byte in the current block
+    std::size_t remaining; // free bytes in the current block
+    std::size_t bytes;     // bytes of string data stored (including '\0')
+
+    const char *store(Mystring_view s);
+    void grow();
+
+public:
+    Mystring_pool();
+    Mystring_pool(const Mystring_pool &) = delete;
+    Mystring_pool &operator=(const Mystring_pool &) = delete;
+
+    Interned intern(Mystring_view s);
+    Interned intern(Mystring_view s, std::size_t hash);  // hash == std::hash<Mystring_view>{}(s)
+
+    std::size_t size() const { return count; }          // distinct strings
+    std::size_t bytes_used() const { return bytes; }    // string bytes held
+};
+
+class Concurrent_Mystring_pool
+{
+private:
+    static constexpr unsigned stripe_bits = 6;
+    static constexpr std::size_t stripe_count = std::size_t{1} << stripe_bits;
+
+    struct alignas(64) Stripe {     // one cache line per lock
+        std::mutex lock;
+        Mystring_pool pool;
+    };
+    std::unique_ptr<Stripe[]> stripes;
+
+public:
+    Concurrent_Mystring_pool();
+
+    Interned intern(Mystring_view s);   // safe to call from any thread
+
+    std::size_t size() const;           // call when no thread is interning
+    std::size_t bytes_used() const;
+};
+
+namespace std {
+template <>
+struct hash<Interned> {
+    // Equal handles share one address, so hashing the pointer is enough
+    std::size_t operator()(Interned s) const { return std::hash<const char *>{}(s.get_str()); }
+};
+} // namespace std
+
+#endif // _MYSTRING_POOL_H_
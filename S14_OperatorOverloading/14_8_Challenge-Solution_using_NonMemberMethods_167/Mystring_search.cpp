@@ -0,0 +1,211 @@
+// Implements the single-needle search strategies and the Aho-Corasick automaton.
+// --------------------------------------------------------------
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <queue>
+#include "Mystring.h"
+#include "Mystring_search.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr std::size_t short_needle_max = 256;
+
+std::size_t find_byte(const char *h, std::size_t n, char c) {
+    const void *hit = std::memchr(h, c, n);
+    return hit ? static_cast<std::size_t>(static_cast<const char *>(hit) - h) : search_npos;
+}
+
+// Scalar candidate scan: memchr for the first byte, then check the rest
+std::size_t find_scalar(const char *h, std::size_t hn, const char *nd, std::size_t nn, std::size_t pos) {
+    const std::size_t last = hn - nn;
+    while (pos <= last) {
+        const std::size_t hit = find_byte(h + pos, last - pos + 1, nd[0]);
+        if (hit == search_npos)
+            return search_npos;
+        pos += hit;
+        if (std::memcmp(h + pos + 1, nd + 1, nn - 1) == 0)
+            return pos;
+        ++pos;
+    }
+    return search_npos;
+}
+
+// Short needles: compare the first and last needle byte against 16/32
+// haystack positions at once; only positions where both match are verified.
+std::size_t find_short(const char *h, std::size_t hn, const char *nd, std::size_t nn) {
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    {
+        const __m256i first = _mm256_set1_epi8(nd[0]);
+        const __m256i last = _mm256_set1_epi8(nd[nn - 1]);
+        for (; i + nn - 1 + 32 <= hn; i += 32) {
+            const __m256i bf = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(h + i));
+            const __m256i bl = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(h + i + nn - 1));
+            auto mask = static_cast<std::uint32_t>(
+                _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, bf), _mm256_cmpeq_epi8(last, bl))));
+            while (mask != 0) {
+                const unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+                if (std::memcmp(h + i + bit + 1, nd + 1, nn - 2) == 0)
+                    return i + bit;
+                mask &= mask - 1;
+            }
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    {
+        const __m128i first = _mm_set1_epi8(nd[0]);
+        const __m128i last = _mm_set1_epi8(nd[nn - 1]);
+        for (; i + nn - 1 + 16 <= hn; i += 16) {
+            const __m128i bf = _mm_loadu_si128(reinterpret_cast<const __m128i *>(h + i));
+            const __m128i bl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(h + i + nn - 1));
+            auto mask = static_cast<std::uint32_t>(
+                _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, bf), _mm_cmpeq_epi8(last, bl))));
+            while (mask != 0) {
+                const unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+                if (std::memcmp(h + i + bit + 1, nd + 1, nn - 2) == 0)
+                    return i + bit;
+                mask &= mask - 1;
+            }
+        }
+    }
+#endif
+    return find_scalar(h, hn, nd, nn, i);
+}
+
+// Long needles: Boyer-Moore-Horspool. The skip for a byte is the distance
+// from its last occurrence (excluding the final position) to the needle end.
+std::size_t find_long(const char *h, std::size_t hn, const char *nd, std::size_t nn) {
+    std::size_t skip[256];
+    for (std::size_t &s : skip)
+        s = nn;
+    for (std::size_t i = 0; i + 1 < nn; ++i)
+        skip[static_cast<unsigned char>(nd[i])] = nn - 1 - i;
+
+    const unsigned char last = static_cast<unsigned char>(nd[nn - 1]);
+    std::size_t pos = 0;
+    while (pos <= hn - nn) {
+        const unsigned char c = static_cast<unsigned char>(h[pos + nn - 1]);
+        if (c == last && std::memcmp(h + pos, nd, nn - 1) == 0)
+            return pos;
+        pos += skip[c];
+    }
+    return search_npos;
+}
+
+} // namespace
+
+std::size_t find_bytes(const char *haystack, std::size_t haystack_len,
+                       const char *needle, std::size_t needle_len) {
+    if (needle_len == 0)
+        return 0;
+    if (needle_len > haystack_len)
+        return search_npos;
+    if (needle_len == 1)
+        return find_byte(haystack, haystack_len, needle[0]);
+    if (needle_len <= short_needle_max)
+        return find_short(haystack, haystack_len, needle, needle_len);
+    return find_long(haystack, haystack_len, needle, needle_len);
+}
+
+// ===== Multi_searcher (Aho-Corasick) =====
+
+Multi_searcher::Multi_searcher(const std::vector<Mystring> &patterns) {
+    std::vector<Mystring_view> views(patterns.begin(), patterns.end());
+    build(views);
+}
+
+Multi_searcher::Multi_searcher(const std::vector<Mystring_view> &patterns) {
+    build(patterns);
+}
+
+void Multi_searcher::build(const std::vector<Mystring_view> &patterns) {
+    constexpr std::uint32_t none = static_cast<std::uint32_t>(-1);
+
+    // 1) Byte classes: 0 for bytes no pattern uses, 1.. for the others
+    std::fill(std::begin(byte_class), std::end(byte_class), 0);
+    std::size_t classes = 1;
+    for (const Mystring_view &pattern : patterns)
+        for (std::size_t i = 0; i < pattern.size(); ++i) {
+            // With all 256 bytes in use, the last one found keeps class 0 (alone)
+            unsigned char &cls = byte_class[static_cast<unsigned char>(pattern[i])];
+            if (cls == 0 && classes < 256)
+                cls = static_cast<unsigned char>(classes++);
+        }
+    class_bits = 0;
+    while ((std::size_t{1} << class_bits) < classes)
+        ++class_bits;
+    const std::size_t width = std::size_t{1} << class_bits;
+
+    // 2) Trie of all patterns, built in next itself (empty patterns never match)
+    next.assign(width, none);
+    std::vector<std::vector<std::uint32_t>> outputs(1);
+    lengths.clear();
+    for (std::size_t p = 0; p < patterns.size(); ++p) {
+        lengths.push_back(patterns[p].size());
+        if (patterns[p].empty())
+            continue;
+        std::uint32_t state = 0;
+        for (std::size_t i = 0; i < patterns[p].size(); ++i) {
+            const std::size_t slot = (std::size_t{state} << class_bits)
+                                     + byte_class[static_cast<unsigned char>(patterns[p][i])];
+            if (next[slot] == none) {
+                next[slot] = static_cast<std::uint32_t>(outputs.size());
+                outputs.emplace_back();
+                next.resize(next.size() + width, none);
+            }
+            state = next[slot];
+        }
+        outputs[state].push_back(static_cast<std::uint32_t>(p));
+    }
+
+    // 3) Breadth-first: failure links, missing transitions, inherited outputs.
+    // A state's failure state is shallower, so its row is already complete.
+    const std::size_t states = outputs.size();
+    std::vector<std::uint32_t> fail(states, 0);
+    std::queue<std::uint32_t> pending;
+    for (std::size_t c = 0; c < width; ++c) {
+        if (next[c] == none)
+            next[c] = 0;
+        else
+            pending.push(next[c]);
+    }
+    while (!pending.empty()) {
+        const std::uint32_t state = pending.front();
+        pending.pop();
+        const std::vector<std::uint32_t> &inherited = outputs[fail[state]];
+        outputs[state].insert(outputs[state].end(), inherited.begin(), inherited.end());
+        std::uint32_t *row = &next[std::size_t{state} << class_bits];
+        const std::uint32_t *fail_row = &next[std::size_t{fail[state]} << class_bits];
+        for (std::size_t c = 0; c < width; ++c) {
+            if (row[c] != none) {
+                fail[row[c]] = fail_row[c];
+                pending.push(row[c]);
+            } else {
+                row[c] = fail_row[c];
+            }
+        }
+    }
+
+    // 4) Flatten outputs
+    out_begin.assign(states + 1, 0);
+    out_list.clear();
+    for (std::size_t s = 0; s < states; ++s) {
+        out_begin[s] = static_cast<std::uint32_t>(out_list.size());
+        out_list.insert(out_list.end(), outputs[s].begin(), outputs[s].end());
+    }
+    out_begin[states] = static_cast<std::uint32_t>(out_list.size());
+}
+
+std::size_t Multi_searcher::count(Mystring_view text) const {
+    std::size_t matches = 0;
+    find_all(text, [&matches](std::size_t, std::size_t) { ++matches; });
+    return matches;
+}
@@ -0,0 +1,83 @@
+// Substring search engines behind Mystring_view::find.
+//
+// find_bytes() picks a strategy by needle length:
+//   - 1 byte       : std::memchr
+//   - 2..256 bytes : SIMD filter on the needle's first and last byte
+//                    (16 or 32 candidate positions per step, SSE2/AVX2),
+//                    each candidate confirmed with memcmp
+//   - longer       : Boyer-Moore-Horspool (bad-character skip table)
+//   The 256-byte cut-over was measured with 14_9_Benchmarks/SubstringSearch:
+//   the filter stays ahead of Horspool on log text until needles get long
+//   enough for the skip table to jump most of the needle each step.
+//
+// Multi_searcher matches a whole set of patterns in one pass over the text
+// (Aho-Corasick automaton with precomputed transitions):
+//
+//   Multi_searcher m{patterns};               // std::vector<Mystring>
+//   m.find_all(text, [](std::size_t pattern, std::size_t pos) { ... });
+//
+// Transitions are indexed by byte class, not by byte: every byte that occurs
+// in some pattern is a class of its own and all other bytes share class 0,
+// rounded up to a power of two. The table takes states * classes * 4 bytes,
+// with at most one state per pattern byte: the SubstringSearch bench's 200
+// patterns (~1,200 states over 17 distinct bytes) need 32 classes, 151 KiB
+// instead of 1.2 MiB. Only pattern sets that use most of the 256 byte
+// values approach 1 KiB a state.
+// --------------------------------------------------------------
+#ifndef _MYSTRING_SEARCH_H_
+#define _MYSTRING_SEARCH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Mystring_view.h"
+
+class Mystring;
+
+constexpr std::size_t search_npos = static_cast<std::size_t>(-1);
+
+// Index of the first occurrence of needle in haystack, or search_npos
+std::size_t find_bytes(const char *haystack, std::size_t haystack_len,
+                       const char *needle, std::size_t needle_len);
+
+class Multi_searcher
+{
+private:
+    unsigned char byte_class[256];            // byte -> column of next
+    unsigned class_bits;                      // a row of next has 1 << class_bits columns
+    std::vector<std::uint32_t> next;          // (state << class_bits) + class -> state
+    std::vector<std::uint32_t> out_begin;     // outputs of state s: out_list[out_begin[s] .. out_begin[s+1])
+    std::vector<std::uint32_t> out_list;      // pattern indices (own + via failure links)
+    std::vector<std::size_t> lengths;         // pattern lengths
+
+    void build(const std::vector<Mystring_view> &patterns);
+
+public:
+    explicit Multi_searcher(const std::vector<Mystring> &patterns);
+    explicit Multi_searcher(const std::vector<Mystring_view> &patterns);
+
+    std::size_t pattern_count() const { return lengths.size(); }
+    std::size_t table_bytes() const { return next.size() * sizeof(std::uint32_t); }
+
+    // Calls fn(pattern_index, start_position) for every match, in order of match end
+    template <typename Fn>
+    void find_all(Mystring_view text, Fn fn) const;
+
+    // Number of matches of all patterns in text
+    std::size_t count(Mystring_view text) const;
+};
+
+template <typename Fn>
+void Multi_searcher::find_all(Mystring_view text, Fn fn) const {
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(text.data());
+    std::uint32_t state = 0;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        state = next[(static_cast<std::size_t>(state) << class_bits) + byte_class[p[i]]];
+        for (std::uint32_t k = out_begin[state]; k < out_begin[state + 1]; ++k) {
+            const std::uint32_t pattern = out_list[k];
+            fn(static_cast<std::size_t>(pattern), i + 1 - lengths[pattern]);
+        }
+    }
+}
+
+#endif // _MYSTRING_SEARCH_H_
@@ -0,0 +1,293 @@
+// Implements the multikey quicksort behind sort_strings().
+// --------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <utility>
+#include "Mystring.h"
+#include "Mystring_sort.h"
+
+namespace {
+
+// One element being sorted (16 bytes, so partitioning moves little data).
+// key caches characters [depth, depth + 8) of the string for the current
+// depth of its partition, zero-padded past the end. Lengths fit in 32 bits
+// since get_length() is an int; inputs are limited to 2^32 elements.
+struct Sort_item {
+    std::uint64_t key;
+    std::uint32_t len;
+    std::uint32_t index;    // position in the input vector
+};
+
+constexpr std::size_t key_bytes = sizeof(std::uint64_t);
+constexpr std::size_t insertion_max = 16;           // smaller ranges: insertion sort
+constexpr std::size_t radix_min = 1 << 14;          // larger ranges: MSD radix pass
+constexpr std::size_t parallel_min = 1 << 15;       // smaller ranges stay on this thread
+
+// Characters [depth, depth + 8) as a big-endian integer, so integer order
+// matches byte order; bytes past the end read as zero
+std::uint64_t load_key(const char *str, std::size_t len, std::size_t depth) {
+    if (depth >= len)
+        return 0;
+    const std::size_t n = std::min(len - depth, key_bytes);
+    unsigned char bytes[key_bytes] {};
+    std::memcpy(bytes, str + depth, n);
+    std::uint64_t key = 0;
+    for (unsigned char b : bytes)
+        key = (key << 8) | b;       // compiles to a load and bswap
+    return key;
+}
+
+// Partitioning levels a range of n items may use at one depth before it
+// falls back to std::sort: twice the depth a balanced split would need,
+// so inputs that defeat the median of three cost O(n log n), not O(n^2)
+int level_budget(std::size_t n) {
+    int levels = 0;
+    for (; n > 1; n >>= 1)
+        levels += 2;
+    return levels;
+}
+
+std::uint64_t median_key(const Sort_item *items, std::size_t n) {
+    const std::uint64_t a = items[0].key;
+    const std::uint64_t b = items[n / 2].key;
+    const std::uint64_t c = items[n - 1].key;
+    return std::max(std::min(a, b), std::min(std::max(a, b), c));
+}
+
+// Threads parallel_sort_strings may still start
+struct Thread_budget {
+    std::atomic<unsigned> spare;
+    bool try_take() {
+        unsigned n = spare.load(std::memory_order_relaxed);
+        while (n > 0)
+            if (spare.compare_exchange_weak(n, n - 1, std::memory_order_relaxed))
+                return true;
+        return false;
+    }
+    void give_back() { spare.fetch_add(1, std::memory_order_relaxed); }
+};
+
+// One sort of one vector. Partitioning and the radix passes only touch the
+// items array; the strings themselves are read once for the first keys,
+// again only when a key runs out (refill, or a tie in insertion sort).
+// Partitioning scrambles equal strings, so the stable variant breaks ties
+// on the input position.
+template <bool Stable>
+class Sorter
+{
+private:
+    const Mystring *strings;
+    Sort_item *items;
+    Sort_item *scratch;                 // same length as items, for radix passes
+    Thread_budget *budget;              // nullptr: sequential
+
+    const char *chars(const Sort_item &item) const { return strings[item.index].get_str(); }
+    Sort_item *scratch_for(Sort_item *range) const { return scratch + (range - items); }
+
+public:
+    Sorter(const Mystring *s, Sort_item *i, Sort_item *sc, Thread_budget *b)
+        : strings{s}, items{i}, scratch{sc}, budget{b} {}
+
+    // Full comparison of two items that agree on their first depth characters
+    bool less_from(const Sort_item &a, const Sort_item &b, std::size_t depth) const {
+        if (a.key != b.key)
+            return a.key < b.key;
+        const std::size_t shorter = std::min(a.len, b.len);
+        const std::size_t from = std::min(depth + key_bytes, shorter);
+        if (shorter > from) {
+            const int result = std::memcmp(chars(a) + from, chars(b) + from, shorter - from);
+            if (result != 0)
+                return result < 0;
+        }
+        if (a.len != b.len)
+            return a.len < b.len;
+        return Stable && a.index < b.index;
+    }
+
+    void insertion_sort(Sort_item *range, std::size_t n, std::size_t depth) const {
+        for (std::size_t i = 1; i < n; ++i) {
+            const Sort_item item = range[i];
+            std::size_t j = i;
+            for (; j > 0 && less_from(item, range[j - 1], depth); --j)
+                range[j] = range[j - 1];
+            range[j] = item;
+        }
+    }
+
+    // Runs sort on a helper thread when the range is large and the budget
+    // has a thread to spare, otherwise right here; the caller joins
+    template <typename Sort>
+    void maybe_async(std::vector<std::thread> &helpers, std::size_t n, Sort sort) const {
+        if (budget && n > parallel_min && budget->try_take()) {
+            Thread_budget *b = budget;
+            helpers.emplace_back([b, sort] {
+                sort();
+                b->give_back();
+            });
+        } else {
+            sort();
+        }
+    }
+
+    // Items whose keys tie at depth: the ones that end inside this key sort
+    // first (by length, a shorter string is a prefix of a longer one), the
+    // rest continue on the next 8 characters
+    void sort_equal_keys(Sort_item *range, std::size_t n, std::size_t depth) const {
+        const std::size_t next_depth = depth + key_bytes;
+        Sort_item *rest = std::partition(range, range + n, [next_depth](const Sort_item &item) {
+            return item.len <= next_depth;
+        });
+        const std::size_t ended = static_cast<std::size_t>(rest - range);
+        if (ended > 1)
+            std::sort(range, rest, [](const Sort_item &a, const Sort_item &b) {
+                if (a.len != b.len)
+                    return a.len < b.len;
+                return Stable && a.index < b.index;     // equal strings: input order
+            });
+        for (Sort_item *item = rest; item != range + n; ++item)
+            item->key = load_key(chars(*item), item->len, next_depth);
+        sort(rest, n - ended, next_depth, level_budget(n - ended));
+    }
+
+    // Comparison sort of a range whose partitioning ran out of levels; the
+    // cached keys still decide most comparisons
+    void fallback_sort(Sort_item *range, std::size_t n, std::size_t depth) const {
+        std::sort(range, range + n, [this, depth](const Sort_item &a, const Sort_item &b) {
+            return less_from(a, b, depth);
+        });
+    }
+
+    // Large ranges: one MSD radix pass on the 8 highest key bits that differ
+    // within the range (a stable counting scatter through scratch), then each
+    // bucket is sorted on its own. 256 buckets replace ~8 quicksort levels,
+    // each of which would stream the whole range through the cache.
+    void radix_pass(Sort_item *range, std::size_t n, std::size_t depth, int levels) const {
+        std::uint64_t low = range[0].key, high = range[0].key;
+        for (std::size_t i = 1; i < n; ++i) {
+            low = std::min(low, range[i].key);
+            high = std::max(high, range[i].key);
+        }
+        if (low == high) {                  // common prefix: look further in
+            sort_equal_keys(range, n, depth);
+            return;
+        }
+        // Bits above the highest differing bit are equal, so ordering by the
+        // 8-bit window just below it agrees with ordering by the whole key
+        int top = 63;
+        while (!(((low ^ high) >> top) & 1))
+            --top;
+        const int shift = std::max(0, top - 7);
+        auto digit = [shift](const Sort_item &item) { return static_cast<std::size_t>((item.key >> shift) & 0xFF); };
+
+        std::size_t begin[257] {};
+        for (std::size_t i = 0; i < n; ++i)
+            ++begin[digit(range[i]) + 1];
+        for (std::size_t b = 1; b <= 256; ++b)
+            begin[b] += begin[b - 1];
+        std::size_t next[256];
+        std::copy(begin, begin + 256, next);
+        Sort_item *temp = scratch_for(range);
+        for (std::size_t i = 0; i < n; ++i)
+            temp[next[digit(range[i])]++] = range[i];
+        std::copy(temp, temp + n, range);
+
+        std::vector<std::thread> helpers;
+        for (std::size_t b = 0; b < 256; ++b) {
+            const std::size_t size = begin[b + 1] - begin[b];
+            if (size > 1) {
+                Sort_item *bucket = range + begin[b];
+                maybe_async(helpers, size, [this, bucket, size, depth, levels] { sort(bucket, size, depth, levels); });
+            }
+        }
+        for (std::thread &t : helpers)
+            t.join();
+    }
+
+    // Sort range[0, n), whose strings all agree on their first depth characters.
+    // levels is what is left of the range's level_budget at this depth.
+    void sort(Sort_item *range, std::size_t n, std::size_t depth, int levels) const {
+        if (n >= radix_min) {
+            radix_pass(range, n, depth, levels);
+            return;
+        }
+        while (n > insertion_max) {
+            if (levels-- == 0) {
+                fallback_sort(range, n, depth);
+                return;
+            }
+            // Three-way partition on the cached key: [0, lt) < pivot, [lt, gt) ==, [gt, n) >
+            const std::uint64_t pivot = median_key(range, n);
+            std::size_t lt = 0, i = 0, gt = n;
+            while (i < gt) {
+                if (range[i].key < pivot)
+                    std::swap(range[lt++], range[i++]);
+                else if (range[i].key > pivot)
+                    std::swap(range[i], range[--gt]);
+                else
+                    ++i;
+            }
+
+            std::vector<std::thread> helpers;
+            maybe_async(helpers, lt, [this, range, lt, depth, levels] { sort(range, lt, depth, levels); });
+            if (gt - lt > 1)
+                sort_equal_keys(range + lt, gt - lt, depth);
+            for (std::thread &t : helpers)
+                t.join();
+
+            range += gt;                    // loop on the "greater" part
+            n -= gt;
+        }
+        insertion_sort(range, n, depth);
+    }
+};
+
+// Move v's elements into the order given by items. Building a new vector
+// reads v in random order but writes sequentially, which beats following
+// permutation cycles in place (random reads AND writes).
+void apply_order(std::vector<Mystring> &v, const Sort_item *items) {
+    constexpr std::size_t ahead = 16;       // overlap the cache misses of the gather
+    std::vector<Mystring> sorted;
+    sorted.reserve(v.size());
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        if (i + ahead < v.size())
+            __builtin_prefetch(&v[items[i + ahead].index]);
+        sorted.emplace_back(std::move(v[items[i].index]));
+    }
+    v.swap(sorted);
+}
+
+template <bool Stable>
+void sort_with_keys(std::vector<Mystring> &v, Thread_budget *budget) {
+    const std::size_t n = v.size();
+    // Left uninitialized: every item is written before it is read
+    std::unique_ptr<Sort_item[]> items{new Sort_item[n]};
+    std::unique_ptr<Sort_item[]> scratch{n >= radix_min ? new Sort_item[n] : nullptr};
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto len = static_cast<std::uint32_t>(v[i].get_length());
+        items[i] = Sort_item{load_key(v[i].get_str(), len, 0), len, static_cast<std::uint32_t>(i)};
+    }
+    const Sorter<Stable> sorter{v.data(), items.get(), scratch.get(), budget};
+    sorter.sort(items.get(), n, 0, level_budget(n));
+    apply_order(v, items.get());
+}
+
+} // namespace
+
+void sort_strings(std::vector<Mystring> &v) {
+    sort_with_keys<false>(v, nullptr);
+}
+
+void stable_sort_strings(std::vector<Mystring> &v) {
+    sort_with_keys<true>(v, nullptr);
+}
+
+void parallel_sort_strings(std::vector<Mystring> &v, unsigned threads) {
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    Thread_budget budget{threads - 1};
+    sort_with_keys<true>(v, &budget);
+}
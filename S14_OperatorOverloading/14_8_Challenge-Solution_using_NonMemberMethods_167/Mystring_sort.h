@@ -0,0 +1,36 @@
+// Sorting large collections of Mystring.
+//
+// std::sort compares whole strings: every comparison dereferences two heap
+// buffers and rescans the common prefix from the first byte. sort_strings()
+// is a multikey quicksort on cached prefix keys instead:
+//   - each element gets an 8-byte big-endian key holding its next 8
+//     characters, stored next to the element's pointer and length, so
+//     partitioning compares integers in one contiguous array;
+//   - elements whose keys tie move on to the next 8 characters, so no byte
+//     of a common prefix is compared twice;
+//   - once the order is known the Mystrings are moved into place (pointer
+//     steals, no character copies).
+//   - a range that keeps splitting badly (an input built against the
+//     median-of-three pivot) is finished with std::sort after 2*log2(n)
+//     partitioning levels, so the worst case stays O(n log n).
+//
+//   sort_strings(v);              // ascending, same order as operator<
+//   stable_sort_strings(v);       // equal strings keep their relative order
+//   parallel_sort_strings(v);     // large partitions are sorted on other threads
+//
+// The order is the byte-wise (unsigned char) order used by operator<.
+// --------------------------------------------------------------
+#ifndef _MYSTRING_SORT_H_
+#define _MYSTRING_SORT_H_
+
+#include <vector>
+
+class Mystring;
+
+void sort_strings(std::vector<Mystring> &v);
+void stable_sort_strings(std::vector<Mystring> &v);
+
+// threads == 0 uses std::thread::hardware_concurrency(); the result is stable
+void parallel_sort_strings(std::vector<Mystring> &v, unsigned threads = 0);
+
+#endif // _MYSTRING_SORT_H_
@@ -0,0 +1,492 @@
+// Implements the UTF-8 validation, counting and case folding kernels.
+// --------------------------------------------------------------
+#include <array>
+#include <cstdint>
+#include "Mystring_utf8.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+using byte = unsigned char;
+
+bool is_continuation(byte b) {
+    return (b & 0xC0) == 0x80;
+}
+
+// Length (1-4) of the well-formed sequence starting at s[i], or 0 if the
+// bytes there are malformed or truncated by the end of the input
+inline std::size_t sequence_length(const byte *s, std::size_t i, std::size_t length) {
+    const byte b0 = s[i];
+    if (b0 < 0x80)
+        return 1;
+    if (b0 < 0xC2)                              // stray continuation or overlong 2-byte lead
+        return 0;
+    if (b0 < 0xE0)
+        return (i + 1 < length && is_continuation(s[i + 1])) ? 2 : 0;
+    if (b0 < 0xF0) {
+        if (i + 2 >= length)
+            return 0;
+        const byte lo = (b0 == 0xE0) ? 0xA0 : 0x80;   // E0 80..9F is overlong
+        const byte hi = (b0 == 0xED) ? 0x9F : 0xBF;   // ED A0..BF is a surrogate
+        return (s[i + 1] >= lo && s[i + 1] <= hi && is_continuation(s[i + 2])) ? 3 : 0;
+    }
+    if (b0 < 0xF5) {
+        if (i + 3 >= length)
+            return 0;
+        const byte lo = (b0 == 0xF0) ? 0x90 : 0x80;   // F0 80..8F is overlong
+        const byte hi = (b0 == 0xF4) ? 0x8F : 0xBF;   // F4 90.. is above U+10FFFF
+        return (s[i + 1] >= lo && s[i + 1] <= hi && is_continuation(s[i + 2])
+                && is_continuation(s[i + 3])) ? 4 : 0;
+    }
+    return 0;
+}
+
+// ===== Case folding tables =====
+
+// Every simple case folding of CaseFolding.txt (statuses C and S, Unicode
+// 14.0) whose folded form has the same UTF-8 length, as runs: codepoints
+// first, first + step, ... last each fold to codepoint + delta. The 34
+// simple foldings that change the length are left out.
+struct Fold_run {
+    std::uint32_t first;
+    std::uint32_t last;
+    std::int32_t delta;
+    std::uint32_t step;
+};
+
+constexpr Fold_run fold_runs[] {
+    {0x0041, 0x005A, 32, 1}, {0x00B5, 0x00B5, 775, 1}, {0x00C0, 0x00D6, 32, 1},
+    {0x00D8, 0x00DE, 32, 1}, {0x0100, 0x012E, 1, 2}, {0x0132, 0x0136, 1, 2}, {0x0139, 0x0147, 1, 2},
+    {0x014A, 0x0176, 1, 2}, {0x0178, 0x0178, -121, 1}, {0x0179, 0x017D, 1, 2},
+    {0x0181, 0x0181, 210, 1}, {0x0182, 0x0184, 1, 2}, {0x0186, 0x0186, 206, 1},
+    {0x0187, 0x0187, 1, 1}, {0x0189, 0x018A, 205, 1}, {0x018B, 0x018B, 1, 1},
+    {0x018E, 0x018E, 79, 1}, {0x018F, 0x018F, 202, 1}, {0x0190, 0x0190, 203, 1},
+    {0x0191, 0x0191, 1, 1}, {0x0193, 0x0193, 205, 1}, {0x0194, 0x0194, 207, 1},
+    {0x0196, 0x0196, 211, 1}, {0x0197, 0x0197, 209, 1}, {0x0198, 0x0198, 1, 1},
+    {0x019C, 0x019C, 211, 1}, {0x019D, 0x019D, 213, 1}, {0x019F, 0x019F, 214, 1},
+    {0x01A0, 0x01A4, 1, 2}, {0x01A6, 0x01A6, 218, 1}, {0x01A7, 0x01A7, 1, 1},
+    {0x01A9, 0x01A9, 218, 1}, {0x01AC, 0x01AC, 1, 1}, {0x01AE, 0x01AE, 218, 1},
+    {0x01AF, 0x01AF, 1, 1}, {0x01B1, 0x01B2, 217, 1}, {0x01B3, 0x01B5, 1, 2},
+    {0x01B7, 0x01B7, 219, 1}, {0x01B8, 0x01B8, 1, 1}, {0x01BC, 0x01BC, 1, 1},
+    {0x01C4, 0x01C4, 2, 1}, {0x01C5, 0x01C5, 1, 1}, {0x01C7, 0x01C7, 2, 1}, {0x01C8, 0x01C8, 1, 1},
+    {0x01CA, 0x01CA, 2, 1}, {0x01CB, 0x01DB, 1, 2}, {0x01DE, 0x01EE, 1, 2}, {0x01F1, 0x01F1, 2, 1},
+    {0x01F2, 0x01F4, 1, 2}, {0x01F6, 0x01F6, -97, 1}, {0x01F7, 0x01F7, -56, 1},
+    {0x01F8, 0x021E, 1, 2}, {0x0220, 0x0220, -130, 1}, {0x0222, 0x0232, 1, 2},
+    {0x023B, 0x023B, 1, 1}, {0x023D, 0x023D, -163, 1}, {0x0241, 0x0241, 1, 1},
+    {0x0243, 0x0243, -195, 1}, {0x0244, 0x0244, 69, 1}, {0x0245, 0x0245, 71, 1},
+    {0x0246, 0x024E, 1, 2}, {0x0345, 0x0345, 116, 1}, {0x0370, 0x0372, 1, 2},
+    {0x0376, 0x0376, 1, 1}, {0x037F, 0x037F, 116, 1}, {0x0386, 0x0386, 38, 1},
+    {0x0388, 0x038A, 37, 1}, {0x038C, 0x038C, 64, 1}, {0x038E, 0x038F, 63, 1},
+    {0x0391, 0x03A1, 32, 1}, {0x03A3, 0x03AB, 32, 1}, {0x03C2, 0x03C2, 1, 1},
+    {0x03CF, 0x03CF, 8, 1}, {0x03D0, 0x03D0, -30, 1}, {0x03D1, 0x03D1, -25, 1},
+    {0x03D5, 0x03D5, -15, 1}, {0x03D6, 0x03D6, -22, 1}, {0x03D8, 0x03EE, 1, 2},
+    {0x03F0, 0x03F0, -54, 1}, {0x03F1, 0x03F1, -48, 1}, {0x03F4, 0x03F4, -60, 1},
+    {0x03F5, 0x03F5, -64, 1}, {0x03F7, 0x03F7, 1, 1}, {0x03F9, 0x03F9, -7, 1},
+    {0x03FA, 0x03FA, 1, 1}, {0x03FD, 0x03FF, -130, 1}, {0x0400, 0x040F, 80, 1},
+    {0x0410, 0x042F, 32, 1}, {0x0460, 0x0480, 1, 2}, {0x048A, 0x04BE, 1, 2},
+    {0x04C0, 0x04C0, 15, 1}, {0x04C1, 0x04CD, 1, 2}, {0x04D0, 0x052E, 1, 2},
+    {0x0531, 0x0556, 48, 1}, {0x10A0, 0x10C5, 7264, 1}, {0x10C7, 0x10C7, 7264, 1},
+    {0x10CD, 0x10CD, 7264, 1}, {0x13F8, 0x13FD, -8, 1}, {0x1C88, 0x1C88, 35267, 1},
+    {0x1C90, 0x1CBA, -3008, 1}, {0x1CBD, 0x1CBF, -3008, 1}, {0x1E00, 0x1E94, 1, 2},
+    {0x1E9B, 0x1E9B, -58, 1}, {0x1EA0, 0x1EFE, 1, 2}, {0x1F08, 0x1F0F, -8, 1},
+    {0x1F18, 0x1F1D, -8, 1}, {0x1F28, 0x1F2F, -8, 1}, {0x1F38, 0x1F3F, -8, 1},
+    {0x1F48, 0x1F4D, -8, 1}, {0x1F59, 0x1F5F, -8, 2}, {0x1F68, 0x1F6F, -8, 1},
+    {0x1F88, 0x1F8F, -8, 1}, {0x1F98, 0x1F9F, -8, 1}, {0x1FA8, 0x1FAF, -8, 1},
+    {0x1FB8, 0x1FB9, -8, 1}, {0x1FBA, 0x1FBB, -74, 1}, {0x1FBC, 0x1FBC, -9, 1},
+    {0x1FC8, 0x1FCB, -86, 1}, {0x1FCC, 0x1FCC, -9, 1}, {0x1FD8, 0x1FD9, -8, 1},
+    {0x1FDA, 0x1FDB, -100, 1}, {0x1FE8, 0x1FE9, -8, 1}, {0x1FEA, 0x1FEB, -112, 1},
+    {0x1FEC, 0x1FEC, -7, 1}, {0x1FF8, 0x1FF9, -128, 1}, {0x1FFA, 0x1FFB, -126, 1},
+    {0x1FFC, 0x1FFC, -9, 1}, {0x2132, 0x2132, 28, 1}, {0x2160, 0x216F, 16, 1},
+    {0x2183, 0x2183, 1, 1}, {0x24B6, 0x24CF, 26, 1}, {0x2C00, 0x2C2F, 48, 1},
+    {0x2C60, 0x2C60, 1, 1}, {0x2C63, 0x2C63, -3814, 1}, {0x2C67, 0x2C6B, 1, 2},
+    {0x2C72, 0x2C72, 1, 1}, {0x2C75, 0x2C75, 1, 1}, {0x2C80, 0x2CE2, 1, 2}, {0x2CEB, 0x2CED, 1, 2},
+    {0x2CF2, 0x2CF2, 1, 1}, {0xA640, 0xA66C, 1, 2}, {0xA680, 0xA69A, 1, 2}, {0xA722, 0xA72E, 1, 2},
+    {0xA732, 0xA76E, 1, 2}, {0xA779, 0xA77B, 1, 2}, {0xA77D, 0xA77D, -35332, 1},
+    {0xA77E, 0xA786, 1, 2}, {0xA78B, 0xA78B, 1, 1}, {0xA790, 0xA792, 1, 2}, {0xA796, 0xA7A8, 1, 2},
+    {0xA7B3, 0xA7B3, 928, 1}, {0xA7B4, 0xA7C2, 1, 2}, {0xA7C4, 0xA7C4, -48, 1},
+    {0xA7C6, 0xA7C6, -35384, 1}, {0xA7C7, 0xA7C9, 1, 2}, {0xA7D0, 0xA7D0, 1, 1},
+    {0xA7D6, 0xA7D8, 1, 2}, {0xA7F5, 0xA7F5, 1, 1}, {0xAB70, 0xABBF, -38864, 1},
+    {0xFF21, 0xFF3A, 32, 1}, {0x10400, 0x10427, 40, 1}, {0x104B0, 0x104D3, 40, 1},
+    {0x10570, 0x1057A, 39, 1}, {0x1057C, 0x1058A, 39, 1}, {0x1058C, 0x10592, 39, 1},
+    {0x10594, 0x10595, 39, 1}, {0x10C80, 0x10CB2, 64, 1}, {0x118A0, 0x118BF, 32, 1},
+    {0x16E40, 0x16E5F, 32, 1}, {0x1E900, 0x1E921, 34, 1},
+};
+
+// Every 1- and 2-byte codepoint (U+0000..U+07FF) mapped to its folded form,
+// which is always another 2-byte (or 1-byte for ASCII) codepoint
+constexpr std::array<std::uint16_t, 0x800> make_fold2() {
+    std::array<std::uint16_t, 0x800> t {};
+    for (std::uint32_t cp = 0; cp < 0x800; ++cp)
+        t[cp] = static_cast<std::uint16_t>(cp);
+    for (const Fold_run &run : fold_runs)
+        for (std::uint32_t cp = run.first; cp <= run.last && cp < 0x800; cp += run.step)
+            t[cp] = static_cast<std::uint16_t>(cp + run.delta);
+    return t;
+}
+
+constexpr std::array<std::uint16_t, 0x800> fold2 = make_fold2();
+
+// 3- and 4-byte codepoints fold through two levels: page[cp >> 8] picks a
+// block of 256 deltas (block 0, all zero, for the many pages with nothing
+// to fold). Foldings never leave their plane, so a delta is kept modulo
+// 0x10000 and applied to the low 16 bits only. No codepoint above
+// U+1FFFF folds.
+constexpr std::uint32_t fold_pages_end = 0x200;
+
+constexpr std::size_t count_fold_blocks() {
+    bool used[fold_pages_end] {};
+    std::size_t blocks = 1;
+    for (const Fold_run &run : fold_runs)
+        for (std::uint32_t cp = run.first; cp <= run.last; cp += run.step)
+            if (cp >= 0x800 && !used[cp >> 8]) {
+                used[cp >> 8] = true;
+                ++blocks;
+            }
+    return blocks;
+}
+
+struct Fold_pages {
+    std::array<std::uint8_t, fold_pages_end> page;
+    std::array<std::array<std::uint16_t, 256>, count_fold_blocks()> delta;
+};
+
+constexpr Fold_pages make_fold_pages() {
+    Fold_pages t {};
+    std::uint8_t blocks = 1;
+    for (const Fold_run &run : fold_runs)
+        for (std::uint32_t cp = run.first; cp <= run.last; cp += run.step) {
+            if (cp < 0x800)
+                continue;
+            if (t.page[cp >> 8] == 0)
+                t.page[cp >> 8] = blocks++;
+            t.delta[t.page[cp >> 8]][cp & 0xFF] = static_cast<std::uint16_t>(run.delta);
+        }
+    return t;
+}
+
+constexpr Fold_pages fold_pages = make_fold_pages();
+
+// Folded form of a 3- or 4-byte codepoint; the result has the same length
+inline std::uint32_t fold_wide(std::uint32_t cp) {
+    if (cp >= fold_pages_end << 8)
+        return cp;
+    const std::uint32_t delta = fold_pages.delta[fold_pages.page[cp >> 8]][cp & 0xFF];
+    return (cp & ~0xFFFFu) | ((cp + delta) & 0xFFFFu);
+}
+
+// Fold the character at s[i] into d[i..] and return its length in bytes
+// (malformed bytes are copied through one at a time)
+// 2-byte characters (Latin, Greek, Cyrillic, ...) are the common case and
+// get their own small, always-inlined step
+inline bool fold_two_byte(const byte *s, std::size_t i, std::size_t length, byte *d) {
+    const byte b0 = s[i];
+    if (b0 < 0xC2 || b0 >= 0xE0 || i + 1 >= length || !is_continuation(s[i + 1]))
+        return false;
+    const std::uint16_t cp = fold2[((b0 & 0x1F) << 6) | (s[i + 1] & 0x3F)];
+    d[i] = static_cast<byte>(0xC0 | (cp >> 6));
+    d[i + 1] = static_cast<byte>(0x80 | (cp & 0x3F));
+    return true;
+}
+
+std::size_t fold_char(const byte *s, std::size_t i, std::size_t length, byte *d) {
+    const byte b0 = s[i];
+    if (b0 < 0x80) {
+        d[i] = static_cast<byte>(static_cast<unsigned>(b0 - 'A') < 26u ? b0 | 0x20 : b0);
+        return 1;
+    }
+    if (fold_two_byte(s, i, length, d))
+        return 2;
+    const std::size_t n = sequence_length(s, i, length);
+    if (n == 3) {
+        const std::uint32_t cp = fold_wide(((b0 & 0x0Fu) << 12) | ((s[i + 1] & 0x3Fu) << 6) | (s[i + 2] & 0x3Fu));
+        d[i] = static_cast<byte>(0xE0 | (cp >> 12));
+        d[i + 1] = static_cast<byte>(0x80 | ((cp >> 6) & 0x3F));
+        d[i + 2] = static_cast<byte>(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    if (n == 4) {
+        const std::uint32_t cp = fold_wide(((b0 & 0x07u) << 18) | ((s[i + 1] & 0x3Fu) << 12)
+                                           | ((s[i + 2] & 0x3Fu) << 6) | (s[i + 3] & 0x3Fu));
+        d[i] = static_cast<byte>(0xF0 | (cp >> 18));
+        d[i + 1] = static_cast<byte>(0x80 | ((cp >> 12) & 0x3F));
+        d[i + 2] = static_cast<byte>(0x80 | ((cp >> 6) & 0x3F));
+        d[i + 3] = static_cast<byte>(0x80 | (cp & 0x3F));
+        return 4;
+    }
+    d[i] = b0;
+    return 1;
+}
+
+// Fold a block known to hold only ASCII and 2-byte characters without a
+// branch per character, so dense Greek or Cyrillic text that alternates
+// with ASCII spaces does not pay a misprediction per word
+std::size_t fold_short_block(const byte *s, std::size_t i, std::size_t stop, std::size_t length, byte *d) {
+    while (i < stop) {
+        const unsigned b0 = s[i];
+        const unsigned b1 = (i + 1 < length) ? s[i + 1] : 0;
+        const bool two = b0 >= 0xC2 && (b1 & 0xC0) == 0x80;
+        const bool ascii = b0 < 0x80;
+        const unsigned cp = fold2[two ? ((b0 & 0x1F) << 6) | (b1 & 0x3F) : (ascii ? b0 : 0)];
+        d[i] = static_cast<byte>(two ? 0xC0 | (cp >> 6) : (ascii ? cp : b0));
+        if (two)
+            d[i + 1] = static_cast<byte>(0x80 | (cp & 0x3F));
+        i += 1 + two;
+    }
+    return i;
+}
+
+// Finish a vector block whose ASCII letters are already folded in d:
+// fold the character at each lead byte (bit set in leads). A character may
+// run past the block; returns where the next block starts.
+std::size_t fold_leads(const byte *s, std::size_t i, std::size_t width, unsigned leads,
+                       bool short_only, std::size_t length, byte *d) {
+    if (short_only && static_cast<std::size_t>(__builtin_popcount(leads)) * 4 >= width)
+        return fold_short_block(s, i, i + width, length, d);
+    std::size_t next = i + width;
+    while (leads != 0) {
+        const std::size_t pos = i + static_cast<std::size_t>(__builtin_ctz(leads));
+        leads &= leads - 1;
+        const std::size_t end = pos + (fold_two_byte(s, pos, length, d) ? 2 : fold_char(s, pos, length, d));
+        if (end > next)
+            next = end;
+    }
+    return next;
+}
+
+#if defined(__AVX2__)
+
+// ===== AVX2 validation (Keiser & Lemire, "Validating UTF-8 In Less Than
+// One Instruction Per Byte") =====
+//
+// Each byte is classified together with the byte before it through three
+// 16-entry nibble tables; a bit survives the AND of all three only for an
+// invalid pair. Sequences longer than two bytes are checked by requiring a
+// continuation exactly where a 3- or 4-byte lead two or three bytes back
+// demands one.
+
+constexpr byte too_short = 1 << 0;      // lead or ASCII followed by a continuation-less lead
+constexpr byte too_long = 1 << 1;       // ASCII followed by a continuation
+constexpr byte overlong_3 = 1 << 2;     // E0 80..9F
+constexpr byte too_large = 1 << 3;      // F4 90.. or F5..
+constexpr byte surrogate = 1 << 4;      // ED A0..BF
+constexpr byte overlong_2 = 1 << 5;     // C0 / C1 lead
+constexpr byte too_large_1000 = 1 << 6; // F5.. 80..8F
+constexpr byte overlong_4 = 1 << 6;     // F0 80..8F
+constexpr byte two_conts = 1 << 7;      // continuation after continuation
+constexpr byte carry = too_short | too_long | two_conts;
+
+alignas(16) constexpr byte byte_1_high_table[16] {
+    too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+    two_conts, two_conts, two_conts, two_conts,
+    too_short | overlong_2,
+    too_short,
+    too_short | overlong_3 | surrogate,
+    too_short | too_large | too_large_1000 | overlong_4};
+
+alignas(16) constexpr byte byte_1_low_table[16] {
+    carry | overlong_3 | overlong_2 | overlong_4,
+    carry | overlong_2,
+    carry, carry,
+    carry | too_large,
+    carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+    carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+    carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+    carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+    carry | too_large | too_large_1000 | surrogate,
+    carry | too_large | too_large_1000, carry | too_large | too_large_1000};
+
+alignas(16) constexpr byte byte_2_high_table[16] {
+    too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+    too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+    too_long | overlong_2 | two_conts | overlong_3 | too_large,
+    too_long | overlong_2 | two_conts | surrogate | too_large,
+    too_long | overlong_2 | two_conts | surrogate | too_large,
+    too_short, too_short, too_short, too_short};
+
+__m256i lookup(const byte (&table)[16], __m256i nibbles) {
+    const __m256i t = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(table)));
+    return _mm256_shuffle_epi8(t, nibbles);
+}
+
+// input shifted right by N bytes, with the last N bytes of prev in front
+template <int N>
+__m256i prev(__m256i input, __m256i prev_input) {
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev_input, input, 0x21), 16 - N);
+}
+
+bool avx2_valid(const byte *s, std::size_t length) {
+    const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+    // A lead in the last three bytes still waiting for continuations
+    const __m256i incomplete_max = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+
+    __m256i error = _mm256_setzero_si256();
+    __m256i prev_input = _mm256_setzero_si256();
+    __m256i prev_incomplete = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+        if (_mm256_movemask_epi8(input) == 0) {             // ASCII fast path
+            error = _mm256_or_si256(error, prev_incomplete);
+            prev_incomplete = _mm256_setzero_si256();
+        } else {
+            const __m256i prev1 = prev<1>(input, prev_input);
+            const __m256i special = _mm256_and_si256(
+                _mm256_and_si256(
+                    lookup(byte_1_high_table, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble)),
+                    lookup(byte_1_low_table, _mm256_and_si256(prev1, low_nibble))),
+                lookup(byte_2_high_table, _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble)));
+            const __m256i third = _mm256_subs_epu8(prev<2>(input, prev_input), _mm256_set1_epi8(0xE0 - 0x80));
+            const __m256i fourth = _mm256_subs_epu8(prev<3>(input, prev_input), _mm256_set1_epi8(0xF0 - 0x80));
+            const __m256i must_be_continuation = _mm256_and_si256(_mm256_or_si256(third, fourth),
+                                                                  _mm256_set1_epi8(static_cast<char>(0x80)));
+            error = _mm256_or_si256(error, _mm256_xor_si256(must_be_continuation, special));
+            prev_incomplete = _mm256_subs_epu8(input, incomplete_max);
+        }
+        prev_input = input;
+    }
+    if (!_mm256_testz_si256(error, error))
+        return false;
+
+    // Finish with the scalar decoder, starting at the last lead byte if a
+    // character straddles the end of the vector loop
+    std::size_t start = i;
+    for (std::size_t back = 1; back <= 3 && back <= i; ++back) {
+        if (!is_continuation(s[i - back])) {
+            if (s[i - back] >= 0xC0)
+                start = i - back;
+            break;
+        }
+    }
+    while (start < length) {
+        const std::size_t n = sequence_length(s, start, length);
+        if (n == 0)
+            return false;
+        start += n;
+    }
+    return true;
+}
+
+#endif
+
+} // namespace
+
+// ===== Public kernels =====
+
+bool utf8_valid(Mystring_view s) {
+    const byte *p = reinterpret_cast<const byte *>(s.data());
+    const std::size_t length = s.size();
+#if defined(__AVX2__)
+    return avx2_valid(p, length);
+#else
+    std::size_t i = 0;
+    while (i < length) {
+#if defined(__SSE2__)
+        if (i + 16 <= length
+                && _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i))) == 0) {
+            i += 16;                                        // 16 ASCII bytes
+            continue;
+        }
+#endif
+        const std::size_t stop = (length - i < 64) ? length : i + 64;   // stay scalar a while
+        while (i < stop) {
+            if (p[i] < 0x80) {
+                ++i;
+                continue;
+            }
+            const std::size_t n = sequence_length(p, i, length);
+            if (n == 0)
+                return false;
+            i += n;
+        }
+    }
+    return true;
+#endif
+}
+
+// Codepoints = bytes that are not continuations (0x80..0xBF, which are
+// exactly the bytes <= -65 as signed char)
+std::size_t utf8_length(Mystring_view s) {
+    const byte *p = reinterpret_cast<const byte *>(s.data());
+    const std::size_t length = s.size();
+    std::size_t count = 0;
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i limit = _mm256_set1_epi8(-65);
+    for (; i + 32 <= length; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+        count += static_cast<std::size_t>(__builtin_popcount(
+            static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(v, limit)))));
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i limit16 = _mm_set1_epi8(-65);
+    for (; i + 16 <= length; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+        count += static_cast<std::size_t>(__builtin_popcount(
+            static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi8(v, limit16)))));
+    }
+#endif
+    for (; i < length; ++i)
+        count += !is_continuation(p[i]);
+    return count;
+}
+
+void utf8_fold_case(const char *src, std::size_t length, char *dst) {
+    const byte *s = reinterpret_cast<const byte *>(src);
+    byte *d = reinterpret_cast<byte *>(dst);
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i before_a = _mm256_set1_epi8('A' - 1);
+    const __m256i after_z = _mm256_set1_epi8('Z' + 1);
+    const __m256i bit = _mm256_set1_epi8(0x20);
+    const __m256i lead_min = _mm256_set1_epi8(static_cast<char>(0xC0));
+    const __m256i wide_min = _mm256_set1_epi8(static_cast<char>(0xE0));
+    while (i + 32 <= length) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+        const unsigned non_ascii = static_cast<unsigned>(_mm256_movemask_epi8(v));
+        const __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(v, before_a), _mm256_cmpgt_epi8(after_z, v));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(d + i), _mm256_xor_si256(v, _mm256_and_si256(upper, bit)));
+        if (non_ascii == 0) {
+            i += 32;
+            continue;
+        }
+        // Non-ASCII: decode only at lead bytes (>= 0xC0); continuations
+        // and stray bytes were already copied by the store above
+        const unsigned leads = static_cast<unsigned>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(v, lead_min), v)));
+        const bool short_only = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(v, wide_min), v)) == 0;
+        i = fold_leads(s, i, 32, leads, short_only, length, d);
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i before_a16 = _mm_set1_epi8('A' - 1);
+    const __m128i after_z16 = _mm_set1_epi8('Z' + 1);
+    const __m128i bit16 = _mm_set1_epi8(0x20);
+    const __m128i lead_min16 = _mm_set1_epi8(static_cast<char>(0xC0));
+    const __m128i wide_min16 = _mm_set1_epi8(static_cast<char>(0xE0));
+    while (i + 16 <= length) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+        const unsigned non_ascii = static_cast<unsigned>(_mm_movemask_epi8(v));
+        const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, before_a16), _mm_cmpgt_epi8(after_z16, v));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(d + i), _mm_xor_si128(v, _mm_and_si128(upper, bit16)));
+        if (non_ascii == 0) {
+            i += 16;
+            continue;
+        }
+        const unsigned leads = static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v, lead_min16), v)));
+        const bool short_only = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v, wide_min16), v)) == 0;
+        i = fold_leads(s, i, 16, leads, short_only, length, d);
+    }
+#endif
+    while (i < length)
+        i += fold_char(s, i, length, d);
+}
@@ -0,0 +1,44 @@
+// UTF-8 kernels: validation, codepoint count and case folding.
+//
+// Mystring stores bytes, so get_length() counts bytes and operator- /
+// operator++ only convert ASCII letters. These functions treat the bytes
+// as UTF-8 text:
+//
+//   utf8_valid(s)     : true if s is well-formed UTF-8 (no overlongs,
+//                       surrogates, values above U+10FFFF or truncated
+//                       sequences)
+//   utf8_length(s)    : number of codepoints (assumes valid input; invalid
+//                       input still gives a bounded count, never a crash)
+//   utf8_fold_case()  : Unicode simple case folding (caseless matching:
+//                       "ÄPFEL", "Äpfel" and "äpfel" all fold to "äpfel")
+//   fold_case(m)      : folded copy of a Mystring; fold_case(std::move(m))
+//                       and fold_case_in_place(m) reuse m's buffer
+//
+// Folding applies every simple case folding of Unicode 14.0 (CaseFolding.txt
+// statuses C and S; the tables are built from it) whose folded form has
+// the same encoded length, so folding never reallocates. Left unchanged:
+// one-to-many full foldings (ß -> ss, ligatures), the Turkic dotted I,
+// and the 34 simple foldings that change the length (ſ -> s, Kelvin sign
+// -> k, ẞ -> ß, a few Latin Extended-C/D capitals whose small letter is
+// a 2-byte IPA letter). Malformed bytes are copied through untouched.
+//
+// All kernels work on 32-byte (AVX2) or 16-byte (SSE2) blocks with an
+// ASCII fast path. Folding lowercases the ASCII letters of every block
+// with vector ops and decodes only at lead bytes. With AVX2, validation of
+// non-ASCII text is vectorized too (three nibble lookups per byte pair, as
+// in simdjson); otherwise it falls back to a scalar decoder. Build with
+// -mavx2 (or -march=native).
+// --------------------------------------------------------------
+#ifndef _MYSTRING_UTF8_H_
+#define _MYSTRING_UTF8_H_
+
+#include <cstddef>
+#include "Mystring_view.h"
+
+bool        utf8_valid(Mystring_view s);
+std::size_t utf8_length(Mystring_view s);
+
+// Fold length bytes from src into dst (dst == src folds in place)
+void utf8_fold_case(const char *src, std::size_t length, char *dst);
+
+#endif // _MYSTRING_UTF8_H_
@@ -0,0 +1,96 @@
+// Implements Mystring_view slicing, searching and splitting.
+// --------------------------------------------------------------
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include "Mystring_view.h"
+#include "Mystring_hash.h"
+#include "Mystring_search.h"
+
+Mystring_view::Mystring_view(const char *s)
+    : ptr{s ? s : ""}, len{s ? std::strlen(s) : 0} {
+}
+
+Mystring_view Mystring_view::substr(std::size_t pos, std::size_t count) const {
+    if (pos > len)
+        throw std::out_of_range{"Mystring_view::substr: pos out of range"};
+    return Mystring_view{ptr + pos, std::min(count, len - pos)};
+}
+
+// ===== Searching =====
+
+std::size_t Mystring_view::find(char c, std::size_t pos) const {
+    if (pos >= len)
+        return npos;
+    const void *hit = std::memchr(ptr + pos, c, len - pos);
+    return hit ? static_cast<std::size_t>(static_cast<const char *>(hit) - ptr) : npos;
+}
+
+// Strategy chosen by needle length, see Mystring_search.h
+std::size_t Mystring_view::find(Mystring_view needle, std::size_t pos) const {
+    if (pos > len)
+        return npos;
+    const std::size_t hit = find_bytes(ptr + pos, len - pos, needle.ptr, needle.len);
+    return hit == search_npos ? npos : pos + hit;
+}
+
+std::size_t Mystring_view::rfind(char c, std::size_t pos) const {
+    if (len == 0)
+        return npos;
+    std::size_t i = std::min(pos, len - 1) + 1;
+    while (i-- > 0)
+        if (ptr[i] == c)
+            return i;
+    return npos;
+}
+
+std::size_t Mystring_view::rfind(Mystring_view needle, std::size_t pos) const {
+    if (needle.len > len)
+        return npos;
+    std::size_t i = std::min(pos, len - needle.len) + 1;
+    while (i-- > 0)
+        if (std::memcmp(ptr + i, needle.ptr, needle.len) == 0)
+            return i;
+    return npos;
+}
+
+bool Mystring_view::starts_with(Mystring_view prefix) const {
+    return prefix.len <= len && std::memcmp(ptr, prefix.ptr, prefix.len) == 0;
+}
+
+bool Mystring_view::ends_with(Mystring_view suffix) const {
+    return suffix.len <= len && std::memcmp(ptr + len - suffix.len, suffix.ptr, suffix.len) == 0;
+}
+
+// ===== Splitting =====
+
+void Mystring_view::split(char delim, std::vector<Mystring_view> &out, bool skip_empty) const {
+    out.clear();
+    split(delim, [&out](Mystring_view field) { out.push_back(field); }, skip_empty);
+}
+
+// ===== Comparison and output =====
+
+bool operator==(Mystring_view lhs, Mystring_view rhs) {
+    return lhs.len == rhs.len && std::memcmp(lhs.ptr, rhs.ptr, lhs.len) == 0;
+}
+
+bool operator!=(Mystring_view lhs, Mystring_view rhs) {
+    return !(lhs == rhs);
+}
+
+bool operator<(Mystring_view lhs, Mystring_view rhs) {
+    const std::size_t common = std::min(lhs.len, rhs.len);
+    const int result = common ? std::memcmp(lhs.ptr, rhs.ptr, common) : 0;
+    return result < 0 || (result == 0 && lhs.len < rhs.len);
+}
+
+std::ostream &operator<<(std::ostream &os, Mystring_view rhs) {
+    os.write(rhs.ptr, static_cast<std::streamsize>(rhs.len));
+    return os;
+}
+
+std::size_t std::hash<Mystring_view>::operator()(Mystring_view v) const {
+    return static_cast<std::size_t>(hash_bytes(v.data(), v.size()));
+}
@@ -0,0 +1,83 @@
+// Mystring_view: a non-owning slice of characters (pointer + length).
+//
+// Any Mystring converts to a view implicitly, and every operation here
+// (substr, find, rfind, starts_with, split) returns views into the same
+// characters, so slicing and tokenizing never allocate. The viewed
+// characters must outlive the view. Views are NOT null-terminated; use
+// Mystring{view} to materialize an owned copy.
+//
+// std::hash<Mystring_view> gives the same values as std::hash<Mystring>
+// (hash_bytes in Mystring_hash.h), so views can probe Mystring-keyed tables.
+// --------------------------------------------------------------
+#ifndef _MYSTRING_VIEW_H_
+#define _MYSTRING_VIEW_H_
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <vector>
+
+class Mystring_view
+{
+    friend bool operator==(Mystring_view lhs, Mystring_view rhs);
+    friend bool operator!=(Mystring_view lhs, Mystring_view rhs);
+    friend bool operator<(Mystring_view lhs, Mystring_view rhs);
+    friend std::ostream &operator<<(std::ostream &os, Mystring_view rhs);
+
+private:
+    const char *ptr;
+    std::size_t len;
+
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    constexpr Mystring_view() : ptr{""}, len{0} {}
+    constexpr Mystring_view(const char *s, std::size_t length) : ptr{s}, len{length} {}
+    Mystring_view(const char *s);                 // view of a C string (nullptr -> empty)
+
+    constexpr const char *data() const { return ptr; }
+    constexpr std::size_t size() const { return len; }
+    constexpr bool        empty() const { return len == 0; }
+    constexpr char        operator[](std::size_t i) const { return ptr[i]; }
+
+    // Slicing (throws std::out_of_range if pos > size())
+    Mystring_view substr(std::size_t pos, std::size_t count = npos) const;
+
+    // Searching: index of the first/last match, or npos
+    std::size_t find(char c, std::size_t pos = 0) const;
+    std::size_t find(Mystring_view needle, std::size_t pos = 0) const;
+    std::size_t rfind(char c, std::size_t pos = npos) const;
+    std::size_t rfind(Mystring_view needle, std::size_t pos = npos) const;
+
+    bool starts_with(Mystring_view prefix) const;
+    bool ends_with(Mystring_view suffix) const;
+
+    // Splitting on a delimiter. The callback form calls fn(Mystring_view)
+    // per field and allocates nothing; the vector form reuses out's storage.
+    template <typename Fn>
+    void split(char delim, Fn fn, bool skip_empty = false) const;
+    void split(char delim, std::vector<Mystring_view> &out, bool skip_empty = false) const;
+};
+
+template <typename Fn>
+void Mystring_view::split(char delim, Fn fn, bool skip_empty) const {
+    std::size_t start = 0;
+    while (true) {
+        const std::size_t end = find(delim, start);
+        const std::size_t stop = (end == npos) ? len : end;
+        if (!skip_empty || stop > start)
+            fn(Mystring_view{ptr + start, stop - start});
+        if (end == npos)
+            break;
+        start = end + 1;
+    }
+}
+
+namespace std {
+template <>
+struct hash<Mystring_view> {
+    std::size_t operator()(Mystring_view v) const;
+};
+} // namespace std
+
+#endif // _MYSTRING_VIEW_H_
@@ -5,9 +5,16 @@
 // meaningful console messages.
 // --------------------------------------------------------------
 #include <iostream>
+#include <unordered_map>
 #include "Mystring.h"
+#include "Mystring_fixed.h"
 
 using namespace std;
+using namespace mystring_literals;
+
+// Built by the compiler, stored in read-only data: no startup cost
+constexpr Fixed_Mystring<7> weekdays[] = {"Mon", "Tue", "Wed", "Thu", "Fri"};
+static_assert(weekdays[2] == Fixed_Mystring{"Wed"}, "table is checked at compile time");
 
 int main() {
     cout << boolalpha << endl;
@@ -23,6 +30,7 @@ int main() {
     cout << "[Check] a != b ? " << (a != b) << " (expect true)" << endl;
     cout << "[Order] a < b  ? " << (a < b)  << " (lexical compare)" << endl;
     cout << "[Order] a > b  ? " << (a > b)  << " (lexical compare)" << endl;
+    cout << "[Order] a.compare(b) < 0 ? " << (a.compare(b) < 0) << " (three-way compare)" << endl;
 
     // Lowercase via unary minus
     Mystring s1{"ALPHA"};
@@ -62,6 +70,10 @@ int main() {
     repeat_string = "Echo";
     cout << "[Multi-Concat] Echo + Echo + Echo -> " << (repeat_string + repeat_string + repeat_string) << endl;
 
+    // Builder: measure every part, allocate at most once
+    Mystring built = Mystring::concat(repeat_string, "-", s2, "-", s3);
+    cout << "[Concat Builder] concat(Echo, -, s2, -, s3) -> " << built << endl;
+
     // Pre and post increment semantics (uppercase)
     Mystring s{"delta"};
     ++s; // uppercase in place
@@ -88,6 +100,32 @@ int main() {
     Mystring joined = "Left" + Mystring{"Right"};
     cout << "[Literal Left] \"Left\" + Mystring(\"Right\") -> " << joined << endl;
 
+    // Views: slice and split without allocating
+    Mystring line{"GET /index.html HTTP/1.1"};
+    Mystring_view fields[3];
+    int field_count = 0;
+    line.view().split(' ', [&](Mystring_view f) { if (field_count < 3) fields[field_count++] = f; });
+    cout << "[View] method -> " << fields[0] << ", path -> " << fields[1]
+         << ", version -> " << fields[2].substr(fields[2].find('/') + 1) << endl;
+    cout << "[View] path starts with \"/index\" ? " << fields[1].starts_with("/index") << endl;
+
+    // Hashing: Mystring keys in an unordered_map via std::hash<Mystring>
+    unordered_map<Mystring, int> counts;
+    for (const char *word : {"alpha", "bravo", "alpha", "charlie", "alpha"})
+        ++counts[word];
+    cout << "[Hash] count of \"alpha\" -> " << counts["alpha"] << " (expect 3)" << endl;
+
+    // Compile-time constants: Fixed_Mystring table and the _ms literal
+    Mystring today{weekdays[4]};                // one memcpy, no strlen
+    Mystring who{"Frank"_ms};                   // length known at compile time
+    cout << "[Fixed] weekdays[4] -> " << today << ", \"Frank\"_ms -> " << who << endl;
+
+#ifdef MYSTRING_INSTRUMENT
+    // Built with -DMYSTRING_INSTRUMENT -std=c++20: who constructed, copied, moved
+    cout << "\n[Instrument] Mystring events per call site:" << endl;
+    mystring_instrument::report(cout);
+#endif
+
     return 0;
 }
 
@@ -98,18 +136,47 @@ Summary Notes:
    - Suitable for symmetric operations like +, ==, <, >.
 
 2) Operators implemented:
-   -: lowercase copy
-   +, +=: concatenation
-   ==, !=, <, >: comparisons using std::strcmp
-   * , *=: repetition via simple loop (reuses +)
+   -: lowercase copy (in place when applied to a temporary, e.g. -(a + b))
+   +, +=: concatenation (+= appends in place with geometric growth;
+          a temporary operand of + is reused instead of copied)
+   concat(a, b, ...): variadic builder, at most one allocation
+   ==, !=, <, >, <=, >=: length-aware comparisons using std::memcmp
+   compare(): three-way result for sort/map comparators (one pass per pair)
+   * , *=: repetition sized once, filled by doubling memcpy
    ++ (pre/post): in-place uppercase
+   Case conversion runs 16/32 ASCII bytes per step (SSE2/AVX2, see Mystring_case.h).
+
+   std::hash<Mystring>: fast wyhash-style hash for unordered containers
+   (Hashed_Mystring in Mystring_hash.h caches it for repeated lookups)
+
+   Mystring_view: non-owning pointer + length; substr/find/rfind/split
+   return views, so tokenizing allocates nothing
+
+   sort_strings / stable_sort_strings / parallel_sort_strings (Mystring_sort.h):
+   radix + multikey quicksort on cached 8-byte prefixes, several times
+   faster than std::sort on millions of strings
 
 3) I/O:
    - operator>> reads a single token (whitespace-delimited).
    - For multi-word input with spaces, use std::getline into std::string
      and then assign to Mystring.
+   - Mystring_file (Mystring_file.h) memory-maps a file and yields its lines
+     or records as Mystring_view slices; materialize() makes an owned copy.
+   - get_length() counts bytes. utf8_valid(), utf8_length() and fold_case()
+     (Mystring_utf8.h) treat the bytes as UTF-8 text: "ÄPFEL" and "äpfel"
+     fold to the same string.
 
 4) Memory:
    - Class owns a raw char*; copy/move operations are provided to avoid leaks.
+   - Short strings (< 16 chars) are stored inline (small-string optimization),
+     so "alpha", "Echo", "Left" etc. never allocate.
+   - Cow_Mystring (Mystring_cow.h) is an opt-in copy-on-write variant:
+     copies share one refcounted buffer until ++, *= or += modifies one.
+   - Compact_Mystring (Mystring_compact.h) is a 16-byte read-only layout
+     (length + 4-char prefix + inline rest or pointer) for sort/search keys.
+   - Fixed_Mystring<N> / "..."_ms (Mystring_fixed.h): constexpr strings and
+     tables in read-only data, converted to Mystring with a single memcpy.
+   - -DMYSTRING_INSTRUMENT (C++20) counts copies/moves/allocations per call
+     site, to find copies that should have been moves.
    - In real-world code, prefer std::string or a smart wrapper to avoid manual new/delete.
 */
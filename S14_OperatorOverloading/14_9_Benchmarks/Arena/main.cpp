@@ -0,0 +1,90 @@
+// Section 14 - Benchmark: default allocator vs Mystring_arena
+//
+// Parse-then-discard workload: 1,000,000 tokens (ids, UUID-like keys and
+// URLs, most longer than the 15-char inline buffer) are split out of
+// request lines, stored as Mystring, lightly processed and thrown away.
+// Each request of 1,000 tokens either frees its strings one by one
+// (default resource) or resets an arena once.
+//
+// Build:
+//   V=../../14_8_Challenge-Solution_using_NonMemberMethods_167
+//   g++ -std=c++17 -O2 -I$V main.cpp $V/Mystring*.cpp -o arena_bench
+// --------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include "Mystring.h"
+#include "Mystring_arena.h"
+#include "../Bench_util.h"
+
+using namespace std;
+
+static vector<string> make_requests(size_t requests, size_t tokens_per_request) {
+    vector<string> lines;
+    for (size_t r = 0; r < requests; ++r) {
+        string line;
+        for (size_t t = 0; t < tokens_per_request; ++t) {
+            const size_t k = r * tokens_per_request + t;
+            switch (k % 3) {
+            case 0: line += "id-" + to_string(k); break;
+            case 1: line += "key-3f2a9c1e-" + to_string(k * 2654435761u) + "-b7"; break;
+            default: line += "https://example.com/api/v2/items/" + to_string(k); break;
+            }
+            line += ' ';
+        }
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+// Split, store, touch, discard. Returns a checksum so nothing is optimized away.
+static size_t process(const vector<string> &lines, std::pmr::memory_resource *resource, Mystring_arena *arena) {
+    size_t checksum {0};
+    vector<Mystring> tokens;
+    for (const auto &line : lines) {
+        tokens.clear();
+        Mystring_view{line.data(), line.size()}.split(' ', [&](Mystring_view field) {
+            tokens.emplace_back(field, resource);
+        }, true);
+        for (auto &t : tokens) {
+            t += "#";
+            checksum += static_cast<size_t>(t.get_length());
+        }
+        tokens.clear();
+        if (arena)
+            arena->reset();
+    }
+    return checksum;
+}
+
+int main() {
+    constexpr size_t requests {1000};
+    constexpr size_t per_request {1000};
+    const vector<string> lines = make_requests(requests, per_request);
+    constexpr double strings = requests * per_request;
+
+    cout << "1,000,000 strings in " << requests << " requests" << endl;
+
+    for (int round = 0; round < 2; ++round) {       // second round is warmed up
+        bench::reset_counters();
+        bench::Stopwatch sw;
+        size_t sum = process(lines, std::pmr::get_default_resource(), nullptr);
+        double ns = sw.elapsed_ns();
+        bench::do_not_optimize(sum);
+        cout << left << setw(22) << "default new/delete" << right << fixed << setprecision(1)
+             << setw(8) << ns / strings << " ns/string" << setw(12) << bench::allocations() << " heap allocs" << endl;
+
+        Mystring_arena arena;
+        bench::reset_counters();
+        sw = bench::Stopwatch{};
+        sum = process(lines, &arena, &arena);
+        ns = sw.elapsed_ns();
+        bench::do_not_optimize(sum);
+        cout << left << setw(22) << "Mystring_arena" << right << fixed << setprecision(1)
+             << setw(8) << ns / strings << " ns/string" << setw(12) << bench::allocations() << " heap allocs"
+             << "  (arena holds " << arena.bytes_reserved() / 1024 << " KB)" << endl;
+    }
+    return 0;
+}
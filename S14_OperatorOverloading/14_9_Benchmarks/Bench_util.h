@@ -0,0 +1,101 @@
+// --------------------------------------------------------------
+// Section 14 - Mystring benchmarks: shared helpers
+//
+// Include this header from exactly ONE translation unit per benchmark
+// (the benchmark's main.cpp). It replaces the global operator new/delete
+// with counting versions so each benchmark can report heap allocations.
+//
+//   bench::reset_counters();
+//   ... workload ...
+//   bench::allocations();      // number of operator new calls
+//   bench::bytes_allocated();  // total bytes requested
+// --------------------------------------------------------------
+#ifndef _BENCH_UTIL_H_
+#define _BENCH_UTIL_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace bench {
+
+// Relaxed atomics so multi-threaded benchmarks can count too
+inline std::atomic<std::size_t> g_allocations {0};
+inline std::atomic<std::size_t> g_bytes {0};
+
+inline void reset_counters() {
+    g_allocations.store(0, std::memory_order_relaxed);
+    g_bytes.store(0, std::memory_order_relaxed);
+}
+
+inline std::size_t allocations() { return g_allocations.load(std::memory_order_relaxed); }
+inline std::size_t bytes_allocated() { return g_bytes.load(std::memory_order_relaxed); }
+
+// Wall-clock stopwatch in nanoseconds
+class Stopwatch {
+    std::chrono::steady_clock::time_point start;
+public:
+    Stopwatch() : start{std::chrono::steady_clock::now()} {}
+    double elapsed_ns() const {
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+// Keep the optimizer from discarding a computed value
+template <typename T>
+inline void do_not_optimize(const T &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} // namespace bench
+
+// ===== Counting replacements for the global allocation functions =====
+
+void *operator new(std::size_t size) {
+    bench::g_allocations.fetch_add(1, std::memory_order_relaxed);
+    bench::g_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc{};
+}
+
+void *operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+// Aligned forms (used e.g. by std::pmr::new_delete_resource)
+void *operator new(std::size_t size, std::align_val_t align) {
+    bench::g_allocations.fetch_add(1, std::memory_order_relaxed);
+    bench::g_bytes.fetch_add(size, std::memory_order_relaxed);
+    const std::size_t a = static_cast<std::size_t>(align);
+    void *p = nullptr;
+    if (a <= alignof(std::max_align_t))
+        p = std::malloc(size ? size : 1);      // malloc already satisfies this
+#if !defined(_WIN32)
+    else
+        p = std::aligned_alloc(a, (size + a - 1) / a * a);
+#endif
+    if (p)
+        return p;
+    throw std::bad_alloc{};
+}
+
+void *operator new[](std::size_t size, std::align_val_t align) {
+    return ::operator new(size, align);
+}
+
+// Kept out of line so the compiler does not pair inlined free() with operator new
+[[gnu::noinline]] void bench_release(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p) noexcept { bench_release(p); }
+void operator delete[](void *p) noexcept { bench_release(p); }
+void operator delete(void *p, std::size_t) noexcept { bench_release(p); }
+void operator delete[](void *p, std::size_t) noexcept { bench_release(p); }
+void operator delete(void *p, std::align_val_t) noexcept { bench_release(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { bench_release(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { bench_release(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { bench_release(p); }
+
+#endif // _BENCH_UTIL_H_
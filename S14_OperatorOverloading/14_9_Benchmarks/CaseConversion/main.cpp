@@ -0,0 +1,112 @@
+// Section 14 - Benchmark: case conversion throughput
+//
+// Normalizes a corpus of mixed-case identifiers through operator- (lowercase)
+// and operator++ (uppercase) and reports MB/s next to the original
+// byte-at-a-time std::tolower loop.
+//
+// Build (add -mavx2 or -march=native for the 32-byte path):
+//   V=../../14_8_Challenge-Solution_using_NonMemberMethods_167
+//   g++ -std=c++17 -O2 -I$V main.cpp $V/Mystring*.cpp -o case_bench
+// --------------------------------------------------------------
+#include <cctype>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "Mystring.h"
+#include "../Bench_util.h"
+
+using namespace std;
+
+// Identifiers like "HttpRequestHandler_42" of assorted lengths
+static vector<Mystring> make_identifiers(size_t count) {
+    static const char *words[] {"Http", "Request", "HANDLER", "user", "Id", "Session",
+                                "CONFIG", "value", "Parser", "TOKEN", "buffer", "Index"};
+    vector<Mystring> ids;
+    ids.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        string id;
+        for (size_t w = 0; w < 2 + i % 6; ++w)
+            id += words[(i * 7 + w * 3) % 12];
+        id += "_" + to_string(i);
+        ids.push_back(Mystring{id.c_str()});
+    }
+    return ids;
+}
+
+static void report(const char *label, size_t bytes, double ns, size_t allocs) {
+    cout << left << setw(34) << label << right
+         << setw(10) << fixed << setprecision(0) << bytes / (ns / 1e9) / 1e6 << " MB/s"
+         << setw(12) << allocs << " allocs" << endl;
+}
+
+int main() {
+    constexpr size_t count {1000000};
+    const vector<Mystring> ids = make_identifiers(count);
+    size_t bytes {0};
+    for (const auto &id : ids)
+        bytes += id.get_length();
+    cout << count << " identifiers, " << bytes / 1e6 << " MB" << endl;
+
+    // Baseline: the original scalar loop on a copy
+    {
+        bench::reset_counters();
+        bench::Stopwatch sw;
+        for (const auto &id : ids) {
+            Mystring copy{id};
+            char *p = const_cast<char *>(copy.get_str());
+            for (size_t i = 0; i < std::strlen(p); i++)
+                p[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(p[i])));
+            bench::do_not_optimize(copy);
+        }
+        report("scalar tolower loop (copy)", bytes, sw.elapsed_ns(), bench::allocations());
+    }
+
+    // operator- on an lvalue: copy, then SIMD lowercase
+    {
+        bench::reset_counters();
+        bench::Stopwatch sw;
+        for (const auto &id : ids) {
+            Mystring lower = -id;
+            bench::do_not_optimize(lower);
+        }
+        report("-s (copy)", bytes, sw.elapsed_ns(), bench::allocations());
+    }
+
+    // operator- on an rvalue: lowercase in place, no allocation
+    {
+        vector<Mystring> work = ids;
+        bench::reset_counters();
+        bench::Stopwatch sw;
+        for (auto &id : work)
+            id = -std::move(id);
+        report("-std::move(s) (in place)", bytes, sw.elapsed_ns(), bench::allocations());
+    }
+
+    // operator++: uppercase in place
+    {
+        vector<Mystring> work = ids;
+        bench::reset_counters();
+        bench::Stopwatch sw;
+        for (auto &id : work)
+            ++id;
+        report("++s (in place)", bytes, sw.elapsed_ns(), bench::allocations());
+    }
+
+    // One long buffer, where the wide loads dominate
+    {
+        Mystring big{"MixedCase_Identifier-1234567890"};
+        big *= 1 << 17;     // ~4 MB
+        constexpr int reps {50};
+        bench::Stopwatch sw;
+        for (int r = 0; r < reps; ++r) {
+            ++big;
+            big = -std::move(big);
+        }
+        report("4 MB buffer, ++ then - (in place)", 2 * reps * static_cast<size_t>(big.get_length()),
+               sw.elapsed_ns(), 0);
+    }
+
+    return 0;
+}
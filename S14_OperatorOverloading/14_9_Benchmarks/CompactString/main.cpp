@@ -0,0 +1,98 @@
+// Section 14 - Benchmark: Mystring (48 bytes) vs Compact_Mystring (16 bytes)
+//
+// 1,000,000 keys: short codes (<= 12 chars, inline in both layouts) and
+// longer product names (heap in both), shuffled.
+//   sort     : std::sort of a copy of the keys
+//   search   : 1,000,000 binary searches in the sorted keys
+//   hash set : 1,000,000 unordered_set lookups, half hits, half misses
+//              that share length and hash bucket but not the prefix
+//
+// Build:
+//   V=../../14_8_Challenge-Solution_using_NonMemberMethods_167
+//   g++ -std=c++17 -O2 -I$V main.cpp $V/Mystring*.cpp -o compact_bench
+// --------------------------------------------------------------
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "Mystring.h"
+#include "Mystring_compact.h"
+#include "Mystring_hash.h"
+#include "../Bench_util.h"
+
+using namespace std;
+
+static vector<string> make_keys(size_t n) {
+    mt19937_64 rng {11};
+    vector<string> keys;
+    keys.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (i % 2 == 0)
+            keys.push_back("SKU" + to_string(rng() % 100000000));
+        else
+            keys.push_back(to_string(rng() % 1000) + "-wireless-keyboard-" + to_string(i));
+    }
+    shuffle(keys.begin(), keys.end(), rng);
+    return keys;
+}
+
+static void report(const char *workload, const char *layout, double ns, size_t ops) {
+    cout << "  " << left << setw(10) << workload << setw(18) << layout << right << fixed << setprecision(1)
+         << setw(8) << ns / ops << " ns/op" << endl;
+}
+
+template <typename String>
+static void run(const char *layout, const vector<string> &keys, const vector<string> &probes) {
+    vector<String> values;
+    values.reserve(keys.size());
+    for (const auto &k : keys)
+        values.emplace_back(k.c_str());
+    vector<String> queries;
+    queries.reserve(probes.size());
+    for (const auto &p : probes)
+        queries.emplace_back(p.c_str());
+
+    vector<String> sorted {values};
+    bench::Stopwatch sw;
+    sort(sorted.begin(), sorted.end());
+    report("sort", layout, sw.elapsed_ns(), sorted.size());
+
+    size_t found {0};
+    sw = bench::Stopwatch{};
+    for (const auto &q : queries)
+        found += binary_search(sorted.begin(), sorted.end(), q);
+    report("search", layout, sw.elapsed_ns(), queries.size());
+    bench::do_not_optimize(found);
+
+    unordered_set<String> set(values.begin(), values.end());
+    found = 0;
+    sw = bench::Stopwatch{};
+    for (const auto &q : queries)
+        found += set.count(q);
+    report("hash set", layout, sw.elapsed_ns(), queries.size());
+    bench::do_not_optimize(found);
+}
+
+int main() {
+    constexpr size_t n {1000000};
+    const vector<string> keys = make_keys(n);
+    vector<string> probes;
+    mt19937_64 rng {5};
+    for (size_t i = 0; i < n; ++i) {
+        string p = keys[rng() % n];
+        if (i % 2 == 1)
+            p[0] = p[0] == 'S' ? 'T' : '#';     // miss with the same length
+        probes.push_back(p);
+    }
+
+    cout << n << " keys, sizeof(Mystring) = " << sizeof(Mystring)
+         << ", sizeof(Compact_Mystring) = " << sizeof(Compact_Mystring) << endl;
+    for (int round = 0; round < 2; ++round) {   // second round is warmed up
+        run<Mystring>("Mystring", keys, probes);
+        run<Compact_Mystring>("Compact_Mystring", keys, probes);
+    }
+    return 0;
+}
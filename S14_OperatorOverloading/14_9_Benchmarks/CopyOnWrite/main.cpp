@@ -0,0 +1,86 @@
+// Section 14 - Benchmark: Mystring vs copy-on-write Cow_Mystring
+//
+// 1. Copy a 1 MB value 1,000 times (deep copy vs refcount bump).
+// 2. Copy-heavy container workload: a vector of 10,000 strings of 1 KB is
+//    passed by value 100 times and each copy modifies 1% of its elements,
+//    the pattern of snapshot/undo stacks and value-semantics APIs.
+//
+// Build:
+//   V=../../14_8_Challenge-Solution_using_NonMemberMethods_167
+//   g++ -std=c++17 -O2 -I$V main.cpp $V/Mystring*.cpp -o cow_bench
+// --------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "Mystring.h"
+#include "Mystring_cow.h"
+#include "../Bench_util.h"
+
+using namespace std;
+
+template <typename String>
+static void copy_big(const char *label, const String &big, int copies) {
+    bench::reset_counters();
+    bench::Stopwatch sw;
+    size_t sum {0};
+    for (int i = 0; i < copies; ++i) {
+        String copy {big};
+        sum += static_cast<size_t>(copy.get_str()[i % copy.get_length()]);
+    }
+    double ns = sw.elapsed_ns();
+    bench::do_not_optimize(sum);
+    cout << left << setw(14) << label << right << fixed << setprecision(1)
+         << setw(12) << ns / copies << " ns/copy" << setw(14) << bench::bytes_allocated() / copies << " bytes/copy" << endl;
+}
+
+// Takes the container by value on purpose: this is the copy being measured
+template <typename String>
+static size_t touch_snapshot(vector<String> snapshot, size_t round) {
+    size_t sum {0};
+    for (size_t i = round % 100; i < snapshot.size(); i += 100) {
+        ++snapshot[i];                              // mutation forces the deferred copy
+        sum += static_cast<size_t>(snapshot[i].get_length());
+    }
+    return sum;
+}
+
+template <typename String>
+static void snapshots(const char *label, const vector<String> &base, size_t rounds) {
+    bench::reset_counters();
+    bench::Stopwatch sw;
+    size_t sum {0};
+    for (size_t r = 0; r < rounds; ++r)
+        sum += touch_snapshot(base, r);
+    double ns = sw.elapsed_ns();
+    bench::do_not_optimize(sum);
+    cout << left << setw(14) << label << right << fixed << setprecision(1)
+         << setw(12) << ns / rounds / 1000.0 << " us/snapshot" << setw(14) << bench::bytes_allocated() / rounds << " bytes/snapshot" << endl;
+}
+
+int main() {
+    const string one_mb(1 << 20, 'm');
+    const Mystring big {one_mb.c_str()};
+    const Cow_Mystring cow_big {big};
+
+    cout << "Copy a 1 MB string" << endl;
+    for (int round = 0; round < 2; ++round) {       // second round is warmed up
+        copy_big("Mystring", big, 1000);
+        copy_big("Cow_Mystring", cow_big, 1000);
+    }
+
+    vector<Mystring> plain;
+    vector<Cow_Mystring> cow;
+    for (size_t i = 0; i < 10000; ++i) {
+        const string s = to_string(i) + string(1024, 'k');
+        plain.emplace_back(s.c_str());
+        cow.emplace_back(s.c_str());
+    }
+
+    cout << "\nPass a 10,000 x 1 KB vector by value, modify 1% of each copy" << endl;
+    for (int round = 0; round < 2; ++round) {
+        snapshots("Mystring", plain, 100);
+        snapshots("Cow_Mystring", cow, 100);
+    }
+    return 0;
+}
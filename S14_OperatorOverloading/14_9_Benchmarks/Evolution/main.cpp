@@ -0,0 +1,233 @@
+// Section 14 - Benchmark: how each Mystring lesson step changes performance
+//
+// The same workloads are compiled once per variant, 14_1 ... 14_8, by
+// pointing -I at the variant's folder:
+//
+//   construct   Mystring s{"..."}
+//   copy        Mystring c{s}
+//   assign      s = Mystring{"..."}         (copy vs move assignment)
+//   push_back   v.push_back(Mystring{"..."}) into a vector that grows
+//   concat      a + b
+//   compare     a == b
+//   sort        std::sort of 100,000 strings
+//   stream      ostringstream << s, then istringstream >> s
+//
+// A workload is reported as "n/a" when the variant lacks the operator it
+// needs (detected at compile time). Assignment-based workloads are skipped
+// for 14_1, whose implicit shallow copy assignment would double-free.
+//
+// bytes/op counts heap bytes requested (push_back includes the vector's own
+// buffer); every variant copies characters straight into each new buffer,
+// so it doubles as "bytes copied".
+// The lesson variants log from their constructors; std::cout is muted
+// while timing, so only the cheap failed-sentry check of each log line
+// remains in their numbers.
+//
+// Build one variant (run_all.sh builds and runs all eight):
+//   V=../../14_3_Mystring-move-assignment_161
+//   g++ -std=c++17 -O2 -DMYSTRING_VARIANT=3 -I$V main.cpp $V/Mystring*.cpp -o evolution_3
+// --------------------------------------------------------------
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Mystring.h"
+#include "../Bench_util.h"
+
+#ifndef MYSTRING_VARIANT
+#error "define MYSTRING_VARIANT to the lesson number (1..8) of the Mystring under -I"
+#endif
+
+using namespace std;
+
+// ===== Feature detection =====
+
+template <typename T, typename = void>
+struct has_plus : false_type {};
+template <typename T>
+struct has_plus<T, void_t<decltype(declval<const T &>() + declval<const T &>())>> : true_type {};
+
+template <typename T, typename = void>
+struct has_equal : false_type {};
+template <typename T>
+struct has_equal<T, void_t<decltype(declval<const T &>() == declval<const T &>())>> : true_type {};
+
+template <typename T, typename = void>
+struct has_less : false_type {};
+template <typename T>
+struct has_less<T, void_t<decltype(declval<const T &>() < declval<const T &>())>> : true_type {};
+
+template <typename T, typename = void>
+struct has_stream_io : false_type {};
+template <typename T>
+struct has_stream_io<T, void_t<decltype(declval<ostream &>() << declval<const T &>()),
+                               decltype(declval<istream &>() >> declval<T &>())>> : true_type {};
+
+constexpr bool safe_assignment = MYSTRING_VARIANT >= 2;
+
+// ===== Harness =====
+
+// Words longer than the 15-char inline buffer of 14_8, so every variant allocates
+static vector<string> make_words(size_t n) {
+    vector<string> words;
+    words.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+        words.push_back("customer-record-" + to_string((i * 2654435761u) % 1000003));
+    return words;
+}
+
+static void report(const char *workload, double ns, size_t ops) {
+    cout << left << setw(12) << workload << right << fixed << setprecision(1)
+         << setw(10) << ns / ops << " ns/op"
+         << setw(8) << setprecision(2) << static_cast<double>(bench::allocations()) / ops << " allocs/op"
+         << setw(9) << setprecision(1) << static_cast<double>(bench::bytes_allocated()) / ops << " bytes/op" << endl;
+}
+
+static void not_available(const char *workload) {
+    cout << left << setw(12) << workload << right << setw(10) << "n/a" << endl;
+}
+
+// Runs untimed setup/teardown with the variants' logging muted
+template <typename Work>
+static void quietly(Work work) {
+    cout.flush();
+    cout.setstate(ios::badbit);
+    work();
+    cout.clear();
+}
+
+template <typename Work>
+static void measure(const char *workload, size_t ops, Work work) {
+    double ns {0};
+    quietly([&] {
+        bench::reset_counters();
+        bench::Stopwatch sw;
+        work();
+        ns = sw.elapsed_ns();
+    });
+    report(workload, ns, ops);
+}
+
+// ===== Workloads =====
+
+// A template so that "if constexpr" discards the operators a variant lacks
+template <typename Mystring>
+static void run_workloads(const vector<string> &words, vector<Mystring> &pool) {
+    const size_t n {words.size()};
+
+    measure("construct", n, [&] {
+        size_t sum {0};
+        for (const auto &w : words) {
+            Mystring s {w.c_str()};
+            sum += static_cast<size_t>(s.get_str()[0]);
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    measure("copy", n, [&] {
+        size_t sum {0};
+        for (const auto &p : pool) {
+            Mystring c {p};
+            sum += static_cast<size_t>(c.get_str()[0]);
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    if constexpr (safe_assignment) {
+        measure("assign", n, [&] {
+            Mystring s;
+            for (const auto &w : words)
+                s = Mystring{w.c_str()};    // 14_2 deep-copies here, 14_3+ moves
+            bench::do_not_optimize(s);
+        });
+    } else {
+        not_available("assign");
+    }
+
+    measure("push_back", n, [&] {
+        vector<Mystring> v;                 // growth relocates via move only if it is noexcept
+        for (const auto &w : words)
+            v.push_back(Mystring{w.c_str()});
+        bench::do_not_optimize(v);
+    });
+
+    if constexpr (has_plus<Mystring>::value) {
+        measure("concat", n, [&] {
+            size_t sum {0};
+            for (size_t i = 0; i < n; ++i) {
+                Mystring s = pool[i] + pool[(i + 1) % n];
+                sum += static_cast<size_t>(s.get_length());
+            }
+            bench::do_not_optimize(sum);
+        });
+    } else {
+        not_available("concat");
+    }
+
+    if constexpr (has_equal<Mystring>::value) {
+        measure("compare", n, [&] {
+            size_t equal {0};
+            for (size_t i = 0; i < n; ++i)
+                equal += pool[i] == pool[(i * 7) % n];
+            bench::do_not_optimize(equal);
+        });
+    } else {
+        not_available("compare");
+    }
+
+    if constexpr (safe_assignment) {
+        vector<Mystring> v;
+        quietly([&] { v = pool; });         // copy made before timing starts
+        measure("sort", n, [&] {
+            if constexpr (has_less<Mystring>::value)
+                sort(v.begin(), v.end());
+            else
+                sort(v.begin(), v.end(), [](const Mystring &a, const Mystring &b) {
+                    return strcmp(a.get_str(), b.get_str()) < 0;
+                });
+            bench::do_not_optimize(v);
+        });
+        quietly([&] { v.clear(); });
+    } else {
+        not_available("sort");
+    }
+
+    if constexpr (has_stream_io<Mystring>::value) {
+        measure("stream", n, [&] {
+            ostringstream out;
+            for (const auto &p : pool)
+                out << p << ' ';
+            istringstream in {out.str()};
+            Mystring s;
+            size_t sum {0};
+            while (in >> s)
+                sum += static_cast<size_t>(s.get_length());
+            bench::do_not_optimize(sum);
+        });
+    } else {
+        not_available("stream");
+    }
+}
+
+int main() {
+    constexpr size_t n {100000};
+    const vector<string> words = make_words(n);
+
+    vector<Mystring> pool;                  // pre-built operands, not timed
+    quietly([&] {
+        pool.reserve(n);
+        for (const auto &w : words)
+            pool.emplace_back(w.c_str());
+    });
+
+    cout << "Mystring variant 14_" << MYSTRING_VARIANT << ", " << n << " strings of ~22 chars" << endl;
+    run_workloads(words, pool);
+
+    cout.setstate(ios::badbit);             // keep the pool's destructor logs quiet
+    return 0;
+}
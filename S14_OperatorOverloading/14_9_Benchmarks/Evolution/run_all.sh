@@ -0,0 +1,11 @@
+#!/bin/sh
+# Builds the evolution benchmark once per Mystring variant and runs each.
+# Usage: ./run_all.sh            (from this folder; needs g++ on PATH)
+set -e
+CXX=${CXX:-g++}
+for dir in ../../14_[1-8]_*/; do
+    n=$(basename "$dir" | sed 's/^14_\([1-8]\)_.*/\1/')
+    "$CXX" -std=c++17 -O2 -DMYSTRING_VARIANT="$n" -I"$dir" main.cpp "$dir"Mystring*.cpp -o evolution_"$n"
+    ./evolution_"$n"
+    echo
+done
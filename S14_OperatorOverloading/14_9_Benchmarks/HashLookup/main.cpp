@@ -0,0 +1,60 @@
+// Section 14 - Benchmark: Mystring-keyed lookups
+//
+// Looks up keys in std::map<Mystring>, std::unordered_map<Mystring> and
+// std::unordered_map<Hashed_Mystring> (cached hash) and reports ns/lookup.
+//
+// Build:
+//   V=../../14_8_Challenge-Solution_using_NonMemberMethods_167
+//   g++ -std=c++17 -O2 -I$V main.cpp $V/Mystring*.cpp -o hash_bench
+// --------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Mystring.h"
+#include "Mystring_hash.h"
+#include "../Bench_util.h"
+
+using namespace std;
+
+template <typename Map, typename Keys>
+static void run(const char *label, Map &index, const Keys &probes, int rounds) {
+    size_t found {0};
+    bench::Stopwatch sw;
+    for (int r = 0; r < rounds; ++r)
+        for (const auto &k : probes)
+            found += index.count(k);
+    bench::do_not_optimize(found);
+    cout << left << setw(36) << label << right << setw(10) << fixed << setprecision(1)
+         << sw.elapsed_ns() / (static_cast<double>(probes.size()) * rounds) << " ns/lookup" << endl;
+}
+
+int main() {
+    constexpr size_t count {200000};
+    constexpr int rounds {5};
+
+    vector<Mystring> keys;
+    vector<Hashed_Mystring> hashed_keys;
+    for (size_t i = 0; i < count; ++i) {
+        const string k = "customer/region-" + to_string(i % 97) + "/account-" + to_string(i);
+        keys.push_back(Mystring{k.c_str()});
+        hashed_keys.push_back(Hashed_Mystring{k.c_str()});
+    }
+
+    map<Mystring, size_t> ordered;
+    unordered_map<Mystring, size_t> hashed;
+    unordered_map<Hashed_Mystring, size_t> cached;
+    for (size_t i = 0; i < count; ++i) {
+        ordered.emplace(keys[i], i);
+        hashed.emplace(keys[i], i);
+        cached.emplace(hashed_keys[i], i);
+    }
+
+    cout << count << " keys, " << rounds << " rounds of lookups" << endl;
+    run("std::map<Mystring>", ordered, keys, rounds);
+    run("std::unordered_map<Mystring>", hashed, keys, rounds);
+    run("std::unordered_map<Hashed_Mystring>", cached, hashed_keys, rounds);
+    return 0;
+}
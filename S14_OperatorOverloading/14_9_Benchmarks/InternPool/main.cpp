@@ -0,0 +1,86 @@
+// Section 14 - Benchmark: interning pool
+//
+// 2,000,000 values drawn from 5,000 distinct strings are stored
+//   a) as separate Mystring objects (every copy owns its bytes), and
+//   b) as Interned handles into one Mystring_pool.
+// Reports heap bytes for each, then the intern latency of
+// Concurrent_Mystring_pool as the number of threads grows.
+//
+// Build:
+//   V=../../14_8_Challenge-Solution_using_NonMemberMethods_167
+//   g++ -std=c++17 -O2 -pthread -I$V main.cpp $V/Mystring*.cpp -o intern_bench
+// --------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Mystring.h"
+#include "Mystring_pool.h"
+#include "../Bench_util.h"
+
+using namespace std;
+
+int main() {
+    constexpr size_t distinct {5000};
+    constexpr size_t total {2000000};
+
+    vector<string> words;
+    for (size_t i = 0; i < distinct; ++i)
+        words.push_back("service.endpoint.metric_name." + to_string(i));
+
+    // a) Plain Mystring copies
+    bench::reset_counters();
+    {
+        vector<Mystring> values;
+        values.reserve(total);
+        const size_t vector_bytes = bench::bytes_allocated();
+        for (size_t i = 0; i < total; ++i)
+            values.push_back(Mystring{words[(i * 7919) % distinct].c_str()});
+        cout << "Mystring copies : " << setw(12) << bench::bytes_allocated() - vector_bytes
+             << " heap bytes for characters (+" << vector_bytes << " for the vector)" << endl;
+    }
+
+    // b) Interned handles
+    bench::reset_counters();
+    {
+        Mystring_pool pool;
+        vector<Interned> values;
+        values.reserve(total);
+        const size_t vector_bytes = bench::bytes_allocated();
+        bench::Stopwatch sw;
+        for (size_t i = 0; i < total; ++i)
+            values.push_back(pool.intern(Mystring_view{words[(i * 7919) % distinct].c_str()}));
+        const double ns = sw.elapsed_ns();
+        cout << "Interned handles: " << setw(12) << bench::bytes_allocated() - vector_bytes
+             << " heap bytes (pool: " << pool.size() << " strings, " << pool.bytes_used() << " string bytes, +"
+             << vector_bytes << " for the vector)" << endl;
+        cout << "single-thread intern: " << fixed << setprecision(1) << ns / total << " ns/op" << endl;
+    }
+
+    // Concurrent interning, same total work split across threads
+    cout << "\nConcurrent_Mystring_pool" << endl;
+    const unsigned max_threads = max(4u, thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        Concurrent_Mystring_pool pool;
+        vector<thread> workers;
+        const size_t per_thread = total / threads;
+        bench::Stopwatch sw;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                size_t sink {0};
+                for (size_t i = 0; i < per_thread; ++i)
+                    sink += pool.intern(Mystring_view{words[(i * 7919 + t * 31) % distinct].c_str()}).size();
+                bench::do_not_optimize(sink);
+            });
+        }
+        for (auto &w : workers)
+            w.join();
+        const double ns = sw.elapsed_ns();
+        cout << setw(3) << threads << " threads: " << fixed << setprecision(1)
+             << ns / (per_thread * threads) << " ns/op wall, "
+             << ns * threads / (per_thread * threads) << " ns/op per thread, "
+             << pool.size() << " distinct" << endl;
+    }
+    return 0;
+}
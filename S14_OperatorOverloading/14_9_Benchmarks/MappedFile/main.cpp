@@ -0,0 +1,130 @@
+// Section 14 - Benchmark: ifstream + getline vs memory-mapped Mystring_file
+//
+// Writes a log-like corpus (default 256 MB, or argv[1] in MB) to the temp
+// directory, then scans it twice, counting lines, bytes and lines that
+// start with "ERROR":
+//   getline : std::getline into std::string, copied into a Mystring
+//   mapped  : Mystring_file::lines(), Mystring_view slices, no copies
+// The open time of the mapped file is reported separately; it does not
+// depend on the file size. The first pass warms the page cache so both
+// scans read from memory. The corpus is deleted at the end.
+//
+// Build:
+//   V=../../14_8_Challenge-Solution_using_NonMemberMethods_167
+//   g++ -std=c++17 -O2 -I$V main.cpp $V/Mystring*.cpp -o mapped_bench
+// --------------------------------------------------------------
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include "Mystring.h"
+#include "Mystring_file.h"
+#include "../Bench_util.h"
+
+using namespace std;
+
+struct Scan_result {
+    size_t lines = 0;
+    size_t bytes = 0;
+    size_t errors = 0;
+};
+
+static void write_corpus(const string &path, size_t target_bytes) {
+    static const char *levels[] = {"INFO", "INFO", "INFO", "WARN", "ERROR"};
+    static const char *messages[] = {
+        "request served", "cache miss for key", "retrying upstream connection",
+        "user logged in", "disk usage above threshold", "timeout waiting for lock"};
+    mt19937_64 rng {5};
+    ofstream out {path, ios::binary};
+    string line;
+    size_t written = 0;
+    while (written < target_bytes) {
+        line = levels[rng() % 5];
+        line += " 2024-05-";
+        line += to_string(10 + rng() % 20);
+        line += ' ';
+        line += messages[rng() % 6];
+        line += " id=";
+        line += to_string(rng() % 1000000000);
+        line += '\n';
+        out << line;
+        written += line.size();
+    }
+}
+
+static Scan_result scan_getline(const string &path) {
+    Scan_result r;
+    ifstream in {path, ios::binary};
+    string line;
+    while (getline(in, line)) {
+        Mystring owned {line.c_str()};
+        ++r.lines;
+        r.bytes += owned.get_length();
+        if (owned.view().starts_with("ERROR"))
+            ++r.errors;
+        bench::do_not_optimize(owned);
+    }
+    return r;
+}
+
+static Scan_result scan_mapped(const Mystring_file &file) {
+    Scan_result r;
+    for (Mystring_view line : file.lines()) {
+        ++r.lines;
+        r.bytes += line.size();
+        if (line.starts_with("ERROR"))
+            ++r.errors;
+    }
+    return r;
+}
+
+static void report(const char *name, const Scan_result &r, double ns, size_t file_bytes) {
+    cout << left << setw(10) << name
+         << right << setw(12) << r.lines << " lines"
+         << setw(10) << fixed << setprecision(1) << ns / 1e6 << " ms"
+         << setw(9) << setprecision(2) << file_bytes / ns << " GB/s"
+         << setw(10) << r.errors << " ERROR\n";
+}
+
+int main(int argc, char *argv[]) {
+    const size_t megabytes = argc > 1 ? static_cast<size_t>(atol(argv[1])) : 256;
+    const string path = (filesystem::temp_directory_path() / "mystring_mapped_bench.txt").string();
+
+    write_corpus(path, megabytes << 20);
+    const size_t file_bytes = static_cast<size_t>(filesystem::file_size(path));
+    cout << "corpus: " << file_bytes / (1 << 20) << " MB at " << path << "\n\n";
+
+    scan_mapped(Mystring_file{path.c_str()});      // warm the page cache
+
+    bench::Stopwatch open_watch;
+    Mystring_file file {path.c_str()};
+    const double open_ns = open_watch.elapsed_ns();
+    cout << "open (mmap): " << fixed << setprecision(1) << open_ns / 1e3 << " us\n\n";
+
+    bench::reset_counters();
+    bench::Stopwatch getline_watch;
+    const Scan_result by_getline = scan_getline(path);
+    const double getline_ns = getline_watch.elapsed_ns();
+    const size_t getline_allocs = bench::allocations();
+
+    bench::reset_counters();
+    bench::Stopwatch mapped_watch;
+    const Scan_result by_mapping = scan_mapped(file);
+    const double mapped_ns = mapped_watch.elapsed_ns();
+    const size_t mapped_allocs = bench::allocations();
+
+    report("getline", by_getline, getline_ns, file_bytes);
+    report("mapped", by_mapping, mapped_ns, file_bytes);
+    cout << "\nallocations: getline " << getline_allocs << ", mapped " << mapped_allocs << "\n";
+    cout << "speedup: " << setprecision(1) << getline_ns / mapped_ns << "x\n";
+
+    if (by_getline.lines != by_mapping.lines || by_getline.bytes != by_mapping.bytes
+            || by_getline.errors != by_mapping.errors)
+        cout << "MISMATCH between the two scans\n";
+
+    filesystem::remove(path);
+    return 0;
+}
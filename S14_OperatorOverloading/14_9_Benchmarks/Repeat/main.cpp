@@ -0,0 +1,59 @@
+// Section 14 - Benchmark: repetition (operator* and operator*=)
+//
+// Repeats short padding/separator units n times for n = 1 .. 1,000,000
+// and reports time, heap allocations and bytes allocated per call.
+// Slow variants are cut off once a single call takes longer than 1 s.
+//
+// Build against 14_8 (single allocation) or 14_7 (repeated operator+):
+//   V=../../14_8_Challenge-Solution_using_NonMemberMethods_167
+//   g++ -std=c++17 -O2 -I$V main.cpp $V/Mystring*.cpp -o repeat_bench
+// --------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include "Mystring.h"
+#include "../Bench_util.h"
+
+using namespace std;
+
+int main() {
+    const char *units[] {"-", "=*", "<pad>", "separator-unit-32-bytes-long----"};
+    constexpr double cutoff_ns {1e9};
+
+    cout << left << setw(36) << "unit" << right << setw(10) << "n"
+         << setw(16) << "ns/call" << setw(12) << "allocs" << setw(16) << "bytes alloc" << endl;
+
+    for (const char *unit : units) {
+        const Mystring u{unit};
+        bool too_slow {false};
+        for (int n = 1; n <= 1000000; n *= 10) {
+            if (too_slow) {
+                cout << left << setw(36) << unit << right << setw(10) << n << setw(16) << "(skipped)" << endl;
+                continue;
+            }
+            // Fewer repetitions for large n keep the run short
+            const int reps = n >= 100000 ? 3 : 1000;
+            bench::reset_counters();
+            bench::Stopwatch sw;
+            for (int r = 0; r < reps; ++r) {
+                Mystring result = u * n;
+                bench::do_not_optimize(result);
+            }
+            const double ns = sw.elapsed_ns() / reps;
+            cout << left << setw(36) << unit << right << setw(10) << n
+                 << setw(16) << fixed << setprecision(0) << ns
+                 << setw(12) << bench::allocations() / reps
+                 << setw(16) << bench::bytes_allocated() / reps << endl;
+            too_slow = ns > cutoff_ns;
+        }
+    }
+
+    // operator*= on a long-lived string
+    Mystring line{"ab"};
+    bench::reset_counters();
+    bench::Stopwatch sw;
+    line *= 1000000;
+    cout << "\n\"ab\" *= 1000000 -> length " << line.get_length() << ", "
+         << bench::allocations() << " allocs, " << fixed << setprecision(0) << sw.elapsed_ns() << " ns" << endl;
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+// Section 14 - Benchmark: small-string optimization
+//
+// Counts heap allocations for a realistic short-key workload
+// (ids and tags under 16 characters): construct, copy, move into a
+// vector, compare, concatenate a short suffix and stream in tokens.
+//
+// Build "after" (14_8 with SSO) and "before" (14_7, heap-only) from this folder:
+//   V=../../14_8_Challenge-Solution_using_NonMemberMethods_167
+//   g++ -std=c++17 -O2 -I$V main.cpp $V/Mystring*.cpp -o sso_after
+//   V=../../14_7_Challenge-Solution_using_member_methods_166
+//   g++ -std=c++17 -O2 -I$V main.cpp $V/Mystring*.cpp -o sso_before
+// --------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Mystring.h"
+#include "../Bench_util.h"
+
+using namespace std;
+
+// Build keys such as "user:1234", "sku-77", "tag_9" (all shorter than 16 chars)
+static vector<string> make_keys(size_t count) {
+    static const char *prefixes[] {"user:", "sku-", "tag_", "id", "order#", "session:"};
+    vector<string> keys;
+    keys.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        keys.push_back(string{prefixes[i % 6]} + to_string(i % 100000));
+    return keys;
+}
+
+static void report(const char *label, size_t ops, size_t allocs, double ns) {
+    cout << left << setw(28) << label
+         << right << setw(12) << allocs << " allocs"
+         << setw(10) << fixed << setprecision(3) << static_cast<double>(allocs) / ops << " allocs/op"
+         << setw(10) << setprecision(1) << ns / ops << " ns/op" << endl;
+}
+
+int main() {
+    constexpr size_t count {200000};
+    const vector<string> keys = make_keys(count);
+
+    // Reserve up front so vector growth is not counted against Mystring
+    vector<Mystring> stored;
+    stored.reserve(count);
+
+    cout << "Short-key workload, " << count << " keys" << endl;
+
+    // 1) Construct from const char*
+    bench::reset_counters();
+    bench::Stopwatch sw;
+    for (const auto &k : keys) {
+        Mystring s{k.c_str()};
+        bench::do_not_optimize(s);
+    }
+    report("construct", count, bench::allocations(), sw.elapsed_ns());
+
+    // 2) Construct + move into a vector
+    bench::reset_counters();
+    sw = bench::Stopwatch{};
+    for (const auto &k : keys)
+        stored.push_back(Mystring{k.c_str()});
+    report("construct + move", count, bench::allocations(), sw.elapsed_ns());
+
+    // 3) Copy
+    bench::reset_counters();
+    sw = bench::Stopwatch{};
+    for (const auto &s : stored) {
+        Mystring copy{s};
+        bench::do_not_optimize(copy);
+    }
+    report("copy", count, bench::allocations(), sw.elapsed_ns());
+
+    // 4) Compare neighbours
+    bench::reset_counters();
+    sw = bench::Stopwatch{};
+    size_t equal {0};
+    for (size_t i = 1; i < stored.size(); ++i)
+        equal += (stored[i] == stored[i - 1]);
+    bench::do_not_optimize(equal);
+    report("compare", count - 1, bench::allocations(), sw.elapsed_ns());
+
+    // 5) Concatenate a short suffix
+    bench::reset_counters();
+    sw = bench::Stopwatch{};
+    const Mystring suffix{":v"};
+    for (const auto &s : stored) {
+        Mystring joined = s + suffix;
+        bench::do_not_optimize(joined);
+    }
+    report("concat (short result)", count, bench::allocations(), sw.elapsed_ns());
+
+    // 6) Stream extraction of short tokens
+    ostringstream text;
+    for (const auto &k : keys)
+        text << k << ' ';
+    istringstream in{text.str()};
+    Mystring token;
+    bench::reset_counters();
+    sw = bench::Stopwatch{};
+    size_t tokens {0};
+    while (in >> token)
+        ++tokens;
+    report("operator>>", tokens, bench::allocations(), sw.elapsed_ns());
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+// Section 14 - Benchmark: std::sort vs sort_strings on vector<Mystring>
+//
+// Sorts N strings (default 1,000,000; pass N on the command line, e.g.
+// 10000000 for the 10M case, which needs ~2 GB of memory) in three shapes:
+//   random     : random lowercase words of 8..24 characters
+//   prefixed   : URLs sharing a 30-character prefix (common-prefix heavy)
+//   duplicates : 1,000 distinct values repeated
+// Each run sorts a fresh copy of the same input.
+//
+// Build:
+//   V=../../14_8_Challenge-Solution_using_NonMemberMethods_167
+//   g++ -std=c++17 -O2 -pthread -I$V main.cpp $V/Mystring*.cpp -o sort_bench
+// --------------------------------------------------------------
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+#include "Mystring.h"
+#include "Mystring_sort.h"
+#include "../Bench_util.h"
+
+using namespace std;
+
+static vector<Mystring> make_input(const string &shape, size_t n) {
+    mt19937_64 rng {42};
+    vector<Mystring> v;
+    v.reserve(n);
+    string s;
+    for (size_t i = 0; i < n; ++i) {
+        if (shape == "random") {
+            s.assign(8 + rng() % 17, ' ');
+            for (char &c : s)
+                c = static_cast<char>('a' + rng() % 26);
+        } else if (shape == "prefixed") {
+            s = "https://example.com/catalog/v2/item/" + to_string(rng() % (n * 4));
+        } else {
+            s = "category-" + to_string(rng() % 1000) + "-name";
+        }
+        v.emplace_back(s.c_str());
+    }
+    return v;
+}
+
+template <typename Sort>
+static void run(const char *label, const vector<Mystring> &input, Sort sort_fn) {
+    vector<Mystring> v {input};
+    bench::Stopwatch sw;
+    sort_fn(v);
+    double ms = sw.elapsed_ns() / 1e6;
+    if (!is_sorted(v.begin(), v.end()))
+        cout << "  NOT SORTED: " << label << endl;
+    cout << "  " << left << setw(24) << label << right << fixed << setprecision(1) << setw(10) << ms << " ms" << endl;
+}
+
+int main(int argc, char *argv[]) {
+    const size_t n = argc > 1 ? static_cast<size_t>(strtoull(argv[1], nullptr, 10)) : 1000000;
+
+    for (const char *shape : {"random", "prefixed", "duplicates"}) {
+        const vector<Mystring> input = make_input(shape, n);
+        cout << shape << ", " << n << " strings" << endl;
+        run("std::sort", input, [](vector<Mystring> &v) { sort(v.begin(), v.end()); });
+        run("sort_strings", input, [](vector<Mystring> &v) { sort_strings(v); });
+        run("std::stable_sort", input, [](vector<Mystring> &v) { stable_sort(v.begin(), v.end()); });
+        run("stable_sort_strings", input, [](vector<Mystring> &v) { stable_sort_strings(v); });
+        run("parallel_sort_strings", input, [](vector<Mystring> &v) { parallel_sort_strings(v); });
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+// Section 14 - Benchmark: tokenizing a stream into Mystring
+//
+// Splits ~64 MB of text held in a std::istringstream with
+//   - the old operator>> path (std::string temporary, then a new Mystring)
+//   - the streaming operator>> (reads into the destination's buffer)
+//   - read_tokens()  (chunked sgetn, elements of the vector reused)
+//   - Token_reader   (chunked sgetn, views only)
+// and reports MB/s and heap allocations.
+//
+// Build:
+//   V=../../14_8_Challenge-Solution_using_NonMemberMethods_167
+//   g++ -std=c++17 -O2 -I$V main.cpp $V/Mystring*.cpp -o stream_bench
+// --------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Mystring.h"
+#include "Mystring_io.h"
+#include "../Bench_util.h"
+
+using namespace std;
+
+static string make_text(size_t bytes) {
+    static const char *words[] {"the", "stream", "of", "tokens", "is", "split", "into", "Mystring",
+                                "values", "without", "temporary", "allocations", "per", "token",
+                                "identifier_with_a_longer_name", "x"};
+    string text;
+    text.reserve(bytes + 64);
+    for (size_t i = 0; text.size() < bytes; ++i) {
+        text += words[(i * 11) % 16];
+        text += (i % 13 == 12) ? '\n' : ' ';
+    }
+    return text;
+}
+
+static void report(const char *label, size_t bytes, double ns, size_t tokens) {
+    cout << left << setw(34) << label << right << setw(9) << fixed << setprecision(0)
+         << bytes / (ns / 1e9) / 1e6 << " MB/s" << setw(12) << bench::allocations() << " allocs"
+         << setw(12) << tokens << " tokens" << endl;
+}
+
+int main() {
+    const string text = make_text(64u << 20);
+
+    {
+        istringstream in{text};
+        Mystring token;
+        string temp;
+        size_t n {0};
+        bench::reset_counters();
+        bench::Stopwatch sw;
+        while (in >> temp) {                      // the pre-streaming operator>>
+            token = Mystring{temp.c_str()};
+            ++n;
+        }
+        report("string temp + new Mystring", text.size(), sw.elapsed_ns(), n);
+    }
+    {
+        istringstream in{text};
+        Mystring token;
+        size_t n {0};
+        bench::reset_counters();
+        bench::Stopwatch sw;
+        while (in >> token)
+            ++n;
+        report("streaming operator>>", text.size(), sw.elapsed_ns(), n);
+    }
+    {
+        istringstream in{text};
+        vector<Mystring> tokens;
+        bench::reset_counters();
+        bench::Stopwatch sw;
+        const size_t n = read_tokens(in, tokens);
+        report("read_tokens (fresh vector)", text.size(), sw.elapsed_ns(), n);
+
+        istringstream again{text};
+        bench::reset_counters();
+        sw = bench::Stopwatch{};
+        const size_t m = read_tokens(again, tokens);
+        report("read_tokens (reused vector)", text.size(), sw.elapsed_ns(), m);
+    }
+    {
+        istringstream in{text};
+        Token_reader reader{in};
+        Mystring_view token;
+        size_t n {0}, chars {0};
+        bench::reset_counters();
+        bench::Stopwatch sw;
+        while (reader.next(token)) {
+            ++n;
+            chars += token.size();
+        }
+        bench::do_not_optimize(chars);
+        report("Token_reader (views)", text.size(), sw.elapsed_ns(), n);
+    }
+    return 0;
+}
@@ -0,0 +1,110 @@
+// Section 14 - Benchmark: substring search
+//
+// Searches a ~16 MB synthetic log for needles of several lengths and
+// compares Mystring_view::find with std::strstr and std::string::find.
+// Then matches 200 patterns in one pass with Multi_searcher (Aho-Corasick)
+// against 200 separate std::string::find scans.
+//
+// Build (add -mavx2 or -march=native for the 32-byte filter):
+//   V=../../14_8_Challenge-Solution_using_NonMemberMethods_167
+//   g++ -std=c++17 -O2 -I$V main.cpp $V/Mystring*.cpp -o search_bench
+// --------------------------------------------------------------
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "Mystring.h"
+#include "Mystring_search.h"
+#include "../Bench_util.h"
+
+using namespace std;
+
+static string make_log(size_t bytes) {
+    static const char *levels[] {"INFO", "WARN", "DEBUG", "ERROR"};
+    static const char *messages[] {"request served in", "cache miss for key", "retrying connection to",
+                                   "user session refreshed", "payload accepted size"};
+    string log;
+    log.reserve(bytes + 128);
+    for (size_t i = 0; log.size() < bytes; ++i) {
+        log += "2026-10-17T12:";
+        log += to_string(10 + i % 50);
+        log += " [";
+        log += levels[i % 4];
+        log += "] worker-";
+        log += to_string(i % 64);
+        log += ' ';
+        log += messages[(i * 7) % 5];
+        log += ' ';
+        log += to_string(i * 2654435761u % 100000);
+        log += '\n';
+    }
+    return log;
+}
+
+static void report(const char *label, size_t bytes, double ns) {
+    cout << "  " << left << setw(22) << label << right << setw(10) << fixed << setprecision(0)
+         << bytes / (ns / 1e9) / 1e6 << " MB/s" << endl;
+}
+
+int main() {
+    const string log = make_log(16u << 20);
+    const Mystring_view haystack{log.data(), log.size()};
+
+    // Needles absent from the log so every engine scans the whole text
+    const vector<string> needles {
+        "#",
+        "FATAL",
+        "worker-99 deadlock",
+        "connection refused by upstream host after timeout",
+        string(200, 'x') + "tail",
+        string(1000, 'y') + "tail",
+    };
+
+    for (const auto &n : needles) {
+        cout << "needle length " << n.size() << endl;
+        size_t sink {0};
+
+        bench::Stopwatch sw;
+        sink += haystack.find(Mystring_view{n.data(), n.size()});
+        report("Mystring_view::find", log.size(), sw.elapsed_ns());
+
+        sw = bench::Stopwatch{};
+        sink += reinterpret_cast<size_t>(std::strstr(log.c_str(), n.c_str()));
+        report("std::strstr", log.size(), sw.elapsed_ns());
+
+        sw = bench::Stopwatch{};
+        sink += log.find(n);
+        report("std::string::find", log.size(), sw.elapsed_ns());
+        bench::do_not_optimize(sink);
+    }
+
+    // Many patterns at once
+    vector<Mystring> patterns;
+    vector<string> std_patterns;
+    for (int i = 0; i < 200; ++i) {
+        const string p = "worker-" + to_string(i) + " user";
+        patterns.push_back(Mystring{p.c_str()});
+        std_patterns.push_back(p);
+    }
+    cout << "200 patterns" << endl;
+
+    bench::Stopwatch sw;
+    const Multi_searcher searcher{patterns};
+    const double build_ns = sw.elapsed_ns();
+    sw = bench::Stopwatch{};
+    const size_t ac_matches = searcher.count(haystack);
+    report("Aho-Corasick", log.size(), sw.elapsed_ns());
+    cout << "  (automaton build " << fixed << setprecision(2) << build_ns / 1e6 << " ms, "
+         << searcher.table_bytes() / 1024 << " KiB table)" << endl;
+
+    sw = bench::Stopwatch{};
+    size_t naive_matches {0};
+    for (const auto &p : std_patterns)
+        for (size_t pos = log.find(p); pos != string::npos; pos = log.find(p, pos + 1))
+            ++naive_matches;
+    report("200 x string::find", log.size(), sw.elapsed_ns());
+    cout << "  matches: " << ac_matches << " / " << naive_matches << endl;
+
+    return 0;
+}
@@ -0,0 +1,129 @@
+// Section 14 - Benchmark: UTF-8 validation, codepoint count and case folding
+//
+// Each corpus is a ~16 MB Mystring built from sentences in one or more
+// scripts. For every corpus the benchmark reports MB/s for
+//   naive validate : byte-at-a-time decoder (the obvious loop)
+//   utf8_valid     : SIMD validation (ASCII fast path, AVX2 lookups)
+//   utf8_length    : SIMD codepoint count
+//   fold_case      : case-folded copy
+//   fold in place  : fold_case_in_place
+// and, for reference, operator- (ASCII-only lowercase copy).
+//
+// Build (add -mavx2 or -march=native for the 32-byte paths):
+//   V=../../14_8_Challenge-Solution_using_NonMemberMethods_167
+//   g++ -std=c++17 -O2 -I$V main.cpp $V/Mystring*.cpp -o utf8_bench
+// --------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "Mystring.h"
+#include "Mystring_utf8.h"
+#include "../Bench_util.h"
+
+using namespace std;
+
+struct Corpus {
+    const char *name;
+    vector<const char *> sentences;
+};
+
+static Mystring build(const Corpus &corpus, size_t target_bytes) {
+    string text;
+    text.reserve(target_bytes + 256);
+    for (size_t i = 0; text.size() < target_bytes; ++i) {
+        text += corpus.sentences[i % corpus.sentences.size()];
+        text += (i % 8 == 7) ? '\n' : ' ';
+    }
+    return Mystring{text.c_str()};
+}
+
+// The obvious decoder: one lead byte at a time, then its continuations
+static bool naive_valid(const Mystring &s) {
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(s.get_str());
+    const size_t n = static_cast<size_t>(s.get_length());
+    size_t i = 0;
+    while (i < n) {
+        const unsigned char b = p[i];
+        size_t extra;
+        unsigned long cp;
+        if (b < 0x80)      { extra = 0; cp = b; }
+        else if (b < 0xC2) return false;
+        else if (b < 0xE0) { extra = 1; cp = b & 0x1F; }
+        else if (b < 0xF0) { extra = 2; cp = b & 0x0F; }
+        else if (b < 0xF5) { extra = 3; cp = b & 0x07; }
+        else               return false;
+        if (i + extra >= n && extra != 0)
+            return false;
+        for (size_t k = 1; k <= extra; ++k) {
+            if ((p[i + k] & 0xC0) != 0x80)
+                return false;
+            cp = (cp << 6) | (p[i + k] & 0x3F);
+        }
+        if ((extra == 2 && (cp < 0x800 || (cp >= 0xD800 && cp < 0xE000)))
+                || (extra == 3 && (cp < 0x10000 || cp > 0x10FFFF)))
+            return false;
+        i += extra + 1;
+    }
+    return true;
+}
+
+template <typename Fn>
+static double mb_per_s(size_t bytes, int reps, Fn fn) {
+    bench::Stopwatch sw;
+    for (int r = 0; r < reps; ++r)
+        fn();
+    return static_cast<double>(bytes) * reps / (sw.elapsed_ns() / 1e9) / 1e6;
+}
+
+int main() {
+    const vector<Corpus> corpora {
+        {"English (ASCII)", {"The quick brown fox jumps over the lazy dog.",
+                             "Pack my box with five dozen liquor jugs!"}},
+        {"French/German", {"Le cœur déçu mais l'âme plutôt naïve, Louÿs rêva de crapaüter.",
+                           "Falsches Üben von Xylophonmusik quält jeden größeren Zwerg."}},
+        {"Russian", {"Съешь же ещё этих мягких французских булок, да выпей чаю.",
+                     "В ЧАЩАХ ЮГА ЖИЛ БЫ ЦИТРУС? ДА, НО ФАЛЬШИВЫЙ ЭКЗЕМПЛЯР!"}},
+        {"Greek", {"Ξεσκεπάζω την ψυχοφθόρα βδελυγμία.",
+                   "ΤΑΧΊΣΤΗ ΑΛΏΠΗΞ ΒΑΦῆΣ ΨΗΜΈΝΗ ΓΗ, ΔΡΑΣΚΕΛΊΖΕΙ ΥΠῈΡ ΝΩΘΡΟῦ ΚΥΝΌΣ."}},
+        {"Chinese/Japanese", {"我能吞下玻璃而不伤身体。", "いろはにほへとちりぬるを、わかよたれそつねならむ。"}},
+        {"Mixed + emoji", {"Order #4512 shipped to Zürich 🚚", "Заказ №4512 отправлен 📦",
+                           "訂單 4512 已發貨 ✅", "ΠΑΡΑΓΓΕΛΊΑ 4512 ΣΤΆΛΘΗΚΕ"}}};
+
+    constexpr size_t target {16 << 20};
+    constexpr int reps {10};
+
+    cout << left << setw(18) << "corpus" << right
+         << setw(10) << "naive" << setw(10) << "valid" << setw(10) << "length"
+         << setw(10) << "fold" << setw(10) << "in place" << setw(10) << "op-"
+         << "   (MB/s)\n";
+
+    for (const Corpus &corpus : corpora) {
+        const Mystring text = build(corpus, target);
+        const size_t bytes = static_cast<size_t>(text.get_length());
+        if (!utf8_valid(text) || !naive_valid(text))
+            cout << corpus.name << ": corpus is not valid UTF-8\n";
+
+        const double naive = mb_per_s(bytes, reps, [&] { bench::do_not_optimize(naive_valid(text)); });
+        const double valid = mb_per_s(bytes, reps, [&] { bench::do_not_optimize(utf8_valid(text)); });
+        const double length = mb_per_s(bytes, reps, [&] { bench::do_not_optimize(utf8_length(text)); });
+        const double fold = mb_per_s(bytes, reps, [&] {
+            Mystring folded = fold_case(text);
+            bench::do_not_optimize(folded);
+        });
+        Mystring work {text};
+        const double in_place = mb_per_s(bytes, reps, [&] {
+            fold_case_in_place(work);
+            bench::do_not_optimize(work);
+        });
+        const double ascii_lower = mb_per_s(bytes, reps, [&] {
+            Mystring lower = -text;
+            bench::do_not_optimize(lower);
+        });
+
+        cout << left << setw(18) << corpus.name << right << fixed << setprecision(0)
+             << setw(10) << naive << setw(10) << valid << setw(10) << length
+             << setw(10) << fold << setw(10) << in_place << setw(10) << ascii_lower << "\n";
+    }
+    return 0;
+}
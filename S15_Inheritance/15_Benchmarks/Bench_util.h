@@ -0,0 +1,58 @@
+// --------------------------------------------------------------
+// Section 15 - Account benchmarks: shared helpers
+//
+// Timing and checking helpers only. Unlike the Section 14 helpers, this
+// header does not replace operator new/delete: shared allocation
+// counters would add contention of their own to the multi-threaded
+// benchmarks.
+//
+//   bench::Stopwatch sw;
+//   ... workload ...
+//   sw.elapsed_ns();
+//
+// Also: bench::do_not_optimize, a small per-thread random generator
+// (bench::Random) and bench::report_check for the correctness checks
+// printed alongside the timings.
+// --------------------------------------------------------------
+#ifndef _S15_BENCH_UTIL_H_
+#define _S15_BENCH_UTIL_H_
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+namespace bench {
+
+// Wall-clock stopwatch in nanoseconds
+class Stopwatch {
+    std::chrono::steady_clock::time_point start;
+public:
+    Stopwatch() : start{std::chrono::steady_clock::now()} {}
+    double elapsed_ns() const {
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+// Keep the optimizer from discarding a computed value
+template <typename T>
+inline void do_not_optimize(const T &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Small per-thread random generator (xorshift64)
+struct Random {
+    std::uint64_t x;
+    explicit Random(std::uint64_t seed) : x{seed * 0x9E3779B97F4A7C15ull + 1} {}
+    std::uint64_t next() { x ^= x << 13; x ^= x >> 7; x ^= x << 17; return x; }
+};
+
+// Prints one line of a correctness check; returns ok
+inline bool report_check(const char *label, bool ok) {
+    std::cout << "  " << std::left << std::setw(44) << label << (ok ? "ok" : "FAILED") << std::right << std::endl;
+    return ok;
+}
+
+} // namespace bench
+
+#endif // _S15_BENCH_UTIL_H_
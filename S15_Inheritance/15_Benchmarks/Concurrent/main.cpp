@@ -0,0 +1,181 @@
+// Section 15 - Benchmark: Concurrent_Account under many threads
+//
+// 1. Stress check. T threads (at least 8, more on bigger machines) race on
+//    a shared account of each class, and the results are checked exactly:
+//      Account / Checking : final balance = start + deposits - successful
+//                           withdrawals (each plus the fee for Checking),
+//                           and a watcher thread never sees it go negative
+//      Savings            : every deposit is credited with its interest
+//      Trust              : 2,000 rounds in which all threads race to
+//                           withdraw from a fresh account; exactly 3 win
+// 2. Throughput as the number of threads grows, same total work, for
+//      sharded    : 65,536 accounts, each thread picks accounts at random
+//      one account: every thread on the same account (worst case)
+//    against an Account guarded by a std::mutex for comparison.
+//    Each operation is a deposit of 100 or a withdrawal of 50.
+//
+// Build:
+//   C=../../15_Inheritance_Challenge
+//   g++ -std=c++17 -O2 -pthread -I$C main.cpp $C/*Account*.cpp $C/Money.cpp -o concurrent_bench
+// --------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Account.h"
+#include "Concurrent_Account.h"
+#include "../Bench_util.h"
+
+using namespace std;
+
+// Runs body(t) on threads 0..threads-1, all released together; returns wall ns
+template <typename Body>
+static double run_threads(unsigned threads, Body body) {
+    atomic<bool> go {false};
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            while (!go.load(memory_order_acquire))
+                this_thread::yield();
+            body(t);
+        });
+    }
+    bench::Stopwatch sw;
+    go.store(true, memory_order_release);
+    for (auto &w : workers)
+        w.join();
+    return sw.elapsed_ns();
+}
+
+// Random deposits and withdrawals on one shared account; fee is what a
+// successful withdrawal costs on top of the amount
+template <typename Acc>
+static bool stress_balance(const char *label, unsigned threads, Money fee) {
+    const Money start {1000};
+    Acc account {"Shared", start};
+    atomic<bool> done {false};
+    atomic<bool> went_negative {false};
+    thread watcher {[&] {
+        while (!done.load(memory_order_acquire))
+            if (account.get_balance() < Money {})
+                went_negative.store(true);
+    }};
+    vector<int64_t> net(threads, 0);        // cents each thread moved in (+) or out (-)
+    run_threads(threads, [&](unsigned t) {
+        bench::Random rng {t + 1};
+        int64_t moved = 0;
+        for (int i = 0; i < 200000; ++i) {
+            const Money amount = Money::from_cents(static_cast<int64_t>(rng.next() % 5000));
+            if (rng.next() % 2) {
+                if (account.deposit(amount))
+                    moved += amount.in_cents();
+            } else if (account.withdraw(amount)) {
+                moved -= (amount + fee).in_cents();
+            }
+        }
+        net[t] = moved;
+    });
+    done.store(true, memory_order_release);
+    watcher.join();
+    int64_t expected = start.in_cents();
+    for (int64_t moved : net)
+        expected += moved;
+    return bench::report_check(label, account.get_balance().in_cents() == expected && !went_negative.load());
+}
+
+static bool stress_savings(unsigned threads) {
+    const double rate = 3.5;
+    Concurrent_Savings_Account account {"Shared", Money {}, rate};
+    vector<int64_t> credited(threads, 0);
+    run_threads(threads, [&](unsigned t) {
+        bench::Random rng {t + 101};
+        int64_t sum = 0;
+        for (int i = 0; i < 200000; ++i) {
+            const Money amount = Money::from_cents(static_cast<int64_t>(rng.next() % 100000));
+            if (account.deposit(amount))
+                sum += (amount + amount.percent(rate)).in_cents();
+        }
+        credited[t] = sum;
+    });
+    int64_t expected = 0;
+    for (int64_t c : credited)
+        expected += c;
+    return bench::report_check("Concurrent_Savings_Account interest", account.get_balance().in_cents() == expected);
+}
+
+static bool stress_trust(unsigned threads) {
+    bool ok = true;
+    for (int round = 0; round < 2000 && ok; ++round) {
+        Concurrent_Trust_Account account {"Shared", Money {10000}, 2.0};
+        atomic<int> wins {0};
+        run_threads(threads, [&](unsigned) {
+            for (int i = 0; i < 4; ++i) {
+                if (account.withdraw(Money {100}))
+                    wins.fetch_add(1);
+                account.deposit(Money {1});
+            }
+        });
+        ok = wins.load() == 3 && account.get_num_withdrawals() == 3;
+    }
+    return bench::report_check("Concurrent_Trust_Account 3 withdrawals", ok);
+}
+
+// An Account made thread-safe the simple way, for comparison
+struct Locked_Account {
+    mutex lock;
+    Account account;
+    Locked_Account(string name, Money balance) : account{name, balance} {}
+    bool deposit(Money amount) { lock_guard<mutex> guard {lock}; return account.deposit(amount); }
+    bool withdraw(Money amount) { lock_guard<mutex> guard {lock}; return account.withdraw(amount); }
+};
+
+template <typename Acc>
+static double throughput(unsigned threads, size_t accounts, size_t total_ops) {
+    deque<Acc> pool;        // the accounts hold a mutex or an atomic: not movable
+    for (size_t i = 0; i < accounts; ++i)
+        pool.emplace_back("Acct-" + to_string(i), Money {100000});
+    const size_t per_thread = total_ops / threads;
+    const double ns = run_threads(threads, [&](unsigned t) {
+        bench::Random rng {t + 7};
+        size_t ok = 0;
+        for (size_t i = 0; i < per_thread; ++i) {
+            const uint64_t r = rng.next();
+            Acc &acc = pool[accounts == 1 ? 0 : r % accounts];
+            ok += (r >> 63) ? acc.deposit(Money::from_cents(10000)) : acc.withdraw(Money::from_cents(5000));
+        }
+        bench::do_not_optimize(ok);
+    });
+    return per_thread * threads / ns * 1e3;       // M ops/s
+}
+
+int main() {
+    const unsigned hardware = max(1u, thread::hardware_concurrency());
+    const unsigned stress_threads = max(8u, hardware);
+
+    cout << "Stress check, " << stress_threads << " threads" << endl;
+    bool ok = true;
+    ok &= stress_balance<Concurrent_Account>("Concurrent_Account balance", stress_threads, Money {});
+    ok &= stress_balance<Concurrent_Checking_Account>("Concurrent_Checking_Account balance and fee",
+                                                      stress_threads, Money::from_cents(150));
+    ok &= stress_savings(stress_threads);
+    ok &= stress_trust(stress_threads);
+
+    constexpr size_t total_ops {8000000};
+    cout << "\nThroughput, " << total_ops << " operations (" << hardware << " hardware threads)" << endl;
+    cout << "threads   sharded atomic   sharded mutex   one atomic   one mutex   (M ops/s)" << endl;
+    const unsigned max_threads = max(4u, hardware);
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        cout << right << setw(7) << threads << fixed << setprecision(1)
+             << setw(17) << throughput<Concurrent_Account>(threads, 65536, total_ops)
+             << setw(16) << throughput<Locked_Account>(threads, 65536, total_ops)
+             << setw(13) << throughput<Concurrent_Account>(threads, 1, total_ops)
+             << setw(12) << throughput<Locked_Account>(threads, 1, total_ops) << endl;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,299 @@
+// Section 15 - Benchmark: Account_Journal
+//
+// 1. Checks. 8 threads make random deposits and withdrawals on one account
+//    of each class (a Trust_Account with a withdrawal made before it was
+//    added among them). The journal is closed and replayed: every account
+//    must display exactly as before. Then a partial record is left at the
+//    end of the file, as a crash in the middle of a write would: replay
+//    must ignore it, cut it off, and keep appending after the last good
+//    record. Last, the file size limit (RLIMIT_FSIZE, POSIX only) makes a
+//    write stop in the middle of a record: that commit, a commit of an
+//    earlier record of the same batch and every later operation must
+//    throw, and replay must find exactly the acknowledged deposits.
+// 2. Sustained journaled operations per second with T client threads, each
+//    op durable (written and synced) before it returns, over 1,000
+//    accounts for about 1 second per row. Ops per sync shows how many
+//    clients group commit lets share each fsync.
+// 3. Recovery: time to replay a journal of 1,000,000 records (1,000
+//    accounts of all four classes, then deposits, withdrawals and fees).
+//
+// Usage: journal_bench [journal path]   (default journal_bench.journal,
+// removed at the end; put it on the disk you want to measure)
+//
+// Build:
+//   C=../../15_Inheritance_Challenge
+//   g++ -std=c++17 -O2 -pthread -I$C main.cpp $C/*Account*.cpp $C/Money.cpp -o journal_bench
+// --------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#ifndef _WIN32
+#include <csignal>
+#include <sys/resource.h>
+#endif
+#include "Account_Journal.h"
+#include "../Bench_util.h"
+
+using namespace std;
+
+static vector<string> snapshot(const Journaled_Accounts &bank) {
+    vector<string> shown;
+    for (size_t id = 0; id < bank.size(); ++id) {
+        ostringstream os;
+        bank.display(os, id);
+        shown.push_back(os.str());
+    }
+    return shown;
+}
+
+static uint64_t file_size(const string &path) {
+    ifstream in {path, ios::binary | ios::ate};
+    return static_cast<uint64_t>(in.tellg());
+}
+
+static bool check(const string &path) {
+    remove(path.c_str());
+    vector<string> before;
+    {
+        Journaled_Accounts bank {path};
+        bank.add(Account {"Larry", Money {5000}});
+        bank.add(Savings_Account {"Moe", Money {5000}, 2.5});
+        bank.add(Checking_Account {"Curly", Money {5000}});
+        Trust_Account trust {"Shemp", Money {20000}, 3.0};
+        trust.withdraw(Money {100});
+        bank.add(trust);
+
+        vector<thread> clients;
+        for (unsigned t = 0; t < 8; ++t) {
+            clients.emplace_back([&bank, t] {
+                bench::Random rng {t + 1};
+                for (int i = 0; i < 500; ++i) {
+                    const uint64_t r = rng.next();
+                    const Money amount = Money::from_cents(static_cast<int64_t>((r >> 8) % 600000));
+                    if (r % 2)
+                        bank.deposit((r >> 1) % 4, amount);
+                    else
+                        bank.withdraw((r >> 1) % 4, amount);
+                }
+            });
+        }
+        for (auto &c : clients)
+            c.join();
+        before = snapshot(bank);
+    }
+
+    bool ok = true;
+    size_t records;
+    {
+        Journaled_Accounts bank {path};
+        records = bank.records_recovered();
+        ok &= bench::report_check("replay rebuilds all four classes", snapshot(bank) == before);
+    }
+    cout << "    (" << records << " records, e.g. " << before[3] << ")" << endl;
+
+    const uint64_t good_size = file_size(path);
+    Money expected;
+    {
+        ofstream torn {path, ios::binary | ios::app};
+        const char partial[20] {1, 2, 3, 4, 1};
+        torn.write(partial, sizeof partial);
+    }
+    {
+        Journaled_Accounts bank {path};
+        ok &= bench::report_check("partial last record ignored", snapshot(bank) == before
+                           && bank.records_recovered() == records && file_size(path) == good_size);
+        bank.deposit(0, Money {1});
+        expected = bank.balance(0);
+    }
+    {
+        Journaled_Accounts bank {path};
+        ok &= bench::report_check("appends continue after the cut", bank.records_recovered() == records + 1
+                           && bank.balance(0) == expected);
+    }
+    remove(path.c_str());
+    return ok;
+}
+
+// Runs body with the file size limit set to `limit` bytes; a write past it
+// fails (EFBIG) instead of raising SIGXFSZ
+#ifndef _WIN32
+template <typename Body>
+static void with_size_limit(uint64_t limit, Body body) {
+    rlimit saved;
+    getrlimit(RLIMIT_FSIZE, &saved);
+    rlimit limited = saved;
+    limited.rlim_cur = limit;
+    signal(SIGXFSZ, SIG_IGN);
+    setrlimit(RLIMIT_FSIZE, &limited);
+    body();
+    setrlimit(RLIMIT_FSIZE, &saved);
+    signal(SIGXFSZ, SIG_DFL);
+}
+#endif
+
+static bool check_failed_write(const string &path) {
+#ifdef _WIN32
+    cout << "  failed write check skipped (no RLIMIT_FSIZE)" << endl;
+    return true;
+#else
+    using Op = Account_Journal::Op;
+    auto throws = [](auto operation) {
+        try {
+            operation();
+        } catch (const runtime_error &) {
+            return true;
+        }
+        return false;
+    };
+
+    // Two records in one batch: the write fails after the first one
+    bool batch_ok;
+    remove(path.c_str());
+    {
+        Account_Journal journal {path};
+        with_size_limit(Account_Journal::header_size + 10, [&] {
+            const uint64_t first = journal.append({Op::deposit, 0, Money {1}});
+            const uint64_t second = journal.append({Op::deposit, 0, Money {1}});
+            batch_ok = throws([&] { journal.commit(second); })
+                       && throws([&] { journal.commit(first); })
+                       && throws([&] { journal.append({Op::deposit, 0, Money {1}}); });
+        });
+    }
+    {
+        size_t replayed = 0;
+        Account_Journal journal {path, [&replayed](const Account_Journal::Record &) { ++replayed; }};
+        batch_ok &= replayed == 1;
+    }
+
+    // One deposit at a time until the limit cuts a record in half
+    const Money start {1000};
+    size_t acknowledged = 0;
+    bool stopped = false;
+    remove(path.c_str());
+    {
+        Journaled_Accounts bank {path};
+        bank.add(Account {"Larry", start});
+        with_size_limit(file_size(path) + 3 * Account_Journal::header_size + 10, [&] {
+            stopped = throws([&] {
+                for (int i = 0; i < 10; ++i) {
+                    bank.deposit(0, Money {1});
+                    ++acknowledged;
+                }
+            });
+            stopped &= throws([&] { bank.deposit(0, Money {1}); });
+        });
+    }
+    Journaled_Accounts bank {path};
+    const bool ok = bench::report_check("failed write stops the journal", batch_ok && stopped && acknowledged == 3
+                                 && bank.balance(0) == start + Money {1} * static_cast<int64_t>(acknowledged));
+    remove(path.c_str());
+    return ok;
+#endif
+}
+
+// Each client makes ops until the deadline; prints ops/s, ops per sync and mean latency
+static void sustained(const string &path, unsigned threads) {
+    constexpr size_t accounts {1000};
+    remove(path.c_str());
+    Journaled_Accounts bank {path};
+    for (size_t i = 0; i < accounts; ++i)
+        bank.add(Savings_Account {"Acct-" + to_string(i), Money {100000}, 1.5});
+    const uint64_t syncs_before = bank.journal_syncs();
+
+    atomic<bool> go {false};
+    atomic<bool> stop {false};
+    vector<size_t> done(threads, 0);
+    vector<thread> clients;
+    for (unsigned t = 0; t < threads; ++t) {
+        clients.emplace_back([&, t] {
+            bench::Random rng {t + 7};
+            while (!go.load(memory_order_acquire))
+                this_thread::yield();
+            size_t ops = 0;
+            while (!stop.load(memory_order_relaxed)) {
+                const uint64_t r = rng.next();
+                if (r >> 63)
+                    bank.deposit(r % accounts, Money::from_cents(10000));
+                else
+                    bank.withdraw(r % accounts, Money::from_cents(5000));
+                ++ops;
+            }
+            done[t] = ops;
+        });
+    }
+    bench::Stopwatch sw;
+    go.store(true, memory_order_release);
+    this_thread::sleep_for(chrono::seconds(1));
+    stop.store(true, memory_order_relaxed);
+    for (auto &c : clients)
+        c.join();
+    const double ns = sw.elapsed_ns();
+
+    size_t ops = 0;
+    for (size_t d : done)
+        ops += d;
+    const uint64_t syncs = bank.journal_syncs() - syncs_before;
+    cout << setw(8) << threads << fixed << setprecision(0) << setw(12) << ops / ns * 1e9
+         << setprecision(2) << setw(18) << static_cast<double>(ops) / max<uint64_t>(syncs, 1)
+         << setprecision(1) << setw(16) << ns / 1e3 / max<size_t>(ops, 1) * threads << endl;
+}
+
+// Writes `records` records in one go (one sync), then times the replay
+static void recovery(const string &path, size_t records) {
+    using Op = Account_Journal::Op;
+    using Kind = Account_Journal::Kind;
+    constexpr size_t accounts {1000};
+    remove(path.c_str());
+    {
+        Account_Journal journal {path};
+        uint64_t position = 0;
+        for (size_t i = 0; i < accounts; ++i)
+            position = journal.append({Op::open, i, Money {1000000}, static_cast<Kind>(i % 4), 2.0,
+                                       "Acct-" + to_string(i)});
+        bench::Random rng {3};
+        for (size_t i = accounts; i < records; ++i) {
+            const uint64_t r = rng.next();
+            const Op op = (r % 3 == 0) ? Op::deposit : (r % 3 == 1) ? Op::withdrawal : Op::fee;
+            position = journal.append({op, (r >> 8) % accounts, Money::from_cents(static_cast<int64_t>((r >> 32) % 1000))});
+        }
+        journal.commit(position);
+    }
+    const uint64_t bytes = file_size(path);
+
+    bench::Stopwatch sw;
+    Journaled_Accounts bank {path};
+    const double ns = sw.elapsed_ns();
+    bench::do_not_optimize(bank.balance(0));
+    cout << "Recovery: " << bank.records_recovered() << " records (" << bytes / 1000000 << " MB) in "
+         << fixed << setprecision(1) << ns / 1e6 << " ms = " << ns / 1e6 * 1e6 / bank.records_recovered()
+         << " ms per million records (" << setprecision(0) << bytes / ns * 1e3 << " MB/s)" << endl;
+    remove(path.c_str());
+}
+
+int main(int argc, char *argv[]) {
+    const string path = argc > 1 ? argv[1] : "journal_bench.journal";
+    const unsigned hardware = max(1u, thread::hardware_concurrency());
+
+    cout << "Checks" << endl;
+    bool ok = check(path);
+    ok &= check_failed_write(path);
+
+    cout << "\nSustained journaled operations, each synced before it returns (" << hardware << " hardware threads)" << endl;
+    cout << " clients       ops/s     ops per sync  mean us per op" << endl;
+    for (unsigned threads = 1; threads <= 16; threads *= 2)
+        sustained(path, threads);
+    remove(path.c_str());
+
+    cout << endl;
+    recovery(path, 1000000);
+    return ok ? 0 : 1;
+}
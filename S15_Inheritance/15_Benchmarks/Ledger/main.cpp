@@ -0,0 +1,128 @@
+// Section 15 - Benchmark: Account_Util vs Account_Ledger batch operations
+//
+// N accounts (default 4,000,000, or argv[1]), a quarter of each class.
+// Each method applies a deposit of 1000 and then a withdrawal of 2000
+// to every account:
+//   Account_Util   : the original helpers, one line of output per account
+//                    (std::cout muted; only the first 1/16 of the accounts
+//                    are timed and the time is scaled up)
+//   object loop    : the same member calls without printing
+//   ledger         : Account_Ledger::deposit / withdraw, one amount
+//   ledger amounts : Account_Ledger with a per-account amount vector
+// The ledger also reports how many operations succeeded, checked against
+// the object loop.
+//
+// Build (the batch loops vectorize at -O3 with AVX2):
+//   C=../../15_Inheritance_Challenge
+//   g++ -std=c++17 -O3 -mavx2 -I$C main.cpp $C/*Account*.cpp $C/Money.cpp -o ledger_bench
+// --------------------------------------------------------------
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "Account_Util.h"
+#include "Account_Ledger.h"
+#include "../Bench_util.h"
+
+using namespace std;
+
+struct Portfolio {
+    vector<Account> accounts;
+    vector<Savings_Account> savings;
+    vector<Checking_Account> checking;
+    vector<Trust_Account> trust;
+};
+
+static Portfolio make_portfolio(size_t n) {
+    Portfolio p;
+    for (size_t i = 0; i < n / 4; ++i) {
+        const string id = to_string(i);
+        const Money balance = Money::from_cents(static_cast<std::int64_t>((i * 7919) % 2000000));
+        p.accounts.push_back(Account {"Acct-" + id, balance});
+        p.savings.push_back(Savings_Account {"Save-" + id, balance, static_cast<double>(i % 6)});
+        p.checking.push_back(Checking_Account {"Chk-" + id, balance});
+        p.trust.push_back(Trust_Account {"Trust-" + id, balance * 4, static_cast<double>(i % 4)});
+    }
+    return p;
+}
+
+template <typename T>
+static size_t apply(vector<T> &accounts, Money dep, Money wd) {
+    size_t ok = 0;
+    for (auto &acc: accounts)
+        ok += acc.deposit(dep);
+    for (auto &acc: accounts)
+        ok += acc.withdraw(wd);
+    return ok;
+}
+
+static void report(const char *label, size_t ops, double ns) {
+    cout << left << setw(18) << label << right << fixed
+         << setw(10) << setprecision(2) << ns / ops << " ns/op"
+         << setw(10) << setprecision(1) << ops / ns * 1e3 << " M ops/s" << endl;
+}
+
+int main(int argc, char *argv[]) {
+    const size_t n = (argc > 1 ? static_cast<size_t>(atol(argv[1])) : 4000000) / 4 * 4;
+    const size_t ops = 2 * n;
+    cout << n << " accounts, deposit 1000 then withdraw 2000" << endl;
+
+    // Original helpers on a 1/16 slice, output discarded
+    {
+        Portfolio slice = make_portfolio(n / 16);
+        streambuf *saved = cout.rdbuf(nullptr);
+        bench::Stopwatch sw;
+        deposit(slice.accounts, 1000);  withdraw(slice.accounts, 2000);
+        deposit(slice.savings, 1000);   withdraw(slice.savings, 2000);
+        deposit(slice.checking, 1000);  withdraw(slice.checking, 2000);
+        deposit(slice.trust, 1000);     withdraw(slice.trust, 2000);
+        const double ns = sw.elapsed_ns() * 16;
+        cout.rdbuf(saved);
+        cout.clear();
+        report("Account_Util", ops, ns);
+    }
+
+    Portfolio objects = make_portfolio(n);
+    Account_Ledger ledger;
+    ledger.add(objects.accounts);
+    ledger.add(objects.savings);
+    ledger.add(objects.checking);
+    ledger.add(objects.trust);
+    Account_Ledger ledger2 = ledger;
+
+    size_t object_ok = 0;
+    {
+        bench::Stopwatch sw;
+        object_ok += apply(objects.accounts, 1000, 2000);
+        object_ok += apply(objects.savings, 1000, 2000);
+        object_ok += apply(objects.checking, 1000, 2000);
+        object_ok += apply(objects.trust, 1000, 2000);
+        report("object loop", ops, sw.elapsed_ns());
+    }
+
+    size_t ledger_ok = 0;
+    {
+        bench::Stopwatch sw;
+        const Success_Bitmap deposited = ledger.deposit(1000);
+        const Success_Bitmap withdrawn = ledger.withdraw(2000);
+        const double ns = sw.elapsed_ns();
+        ledger_ok = deposited.count() + withdrawn.count();
+        report("ledger", ops, ns);
+    }
+
+    {
+        const vector<Money> deposits(n, Money {1000});
+        const vector<Money> withdrawals(n, Money {2000});
+        bench::Stopwatch sw;
+        const Success_Bitmap deposited = ledger2.deposit(deposits);
+        const Success_Bitmap withdrawn = ledger2.withdraw(withdrawals);
+        const double ns = sw.elapsed_ns();
+        bench::do_not_optimize(deposited.count() + withdrawn.count());
+        report("ledger amounts", ops, ns);
+    }
+
+    cout << "\nsucceeded: objects " << object_ok << ", ledger " << ledger_ok
+         << (object_ok == ledger_ok ? " (match)" : " (MISMATCH)") << endl;
+    return 0;
+}
@@ -0,0 +1,233 @@
+// Section 15 - Benchmark: Transfer_Engine
+//
+// 1. Checks. Two 5% Savings accounts pass their balance back and forth,
+//    and $5000.00 goes into a Trust account: no interest or bonus may
+//    appear. Then 16 threads transfer at random between 1,000 accounts of
+//    all four classes (half of the traffic on 4 hot accounts) while a
+//    batch runs on the workers and two more threads send money back and
+//    forth between the same pair in opposite directions. The run must
+//    finish (no deadlock), the total may only go down by the Checking
+//    fees paid, and no balance may go negative.
+// 2. Synchronous transfer() from T client threads over 100,000 accounts:
+//    throughput and p50/p99 latency of a single transfer as T grows and as
+//    more of the traffic goes to 8 hot accounts (each end of a transfer is
+//    hot with probability 0%, 50% or 90%).
+// 3. The same 2,000,000 transfers submitted in batches of 65,536 to a pool
+//    of W workers.
+//
+// Build:
+//   C=../../15_Inheritance_Challenge
+//   g++ -std=c++17 -O2 -pthread -I$C main.cpp $C/*Account*.cpp $C/Money.cpp $C/Transfer_Engine.cpp -o transfer_bench
+// --------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Transfer_Engine.h"
+#include "../Bench_util.h"
+
+using namespace std;
+
+// Picks transfer ends: each end is one of the first `hot` accounts with
+// probability hot_percent, otherwise any account
+struct Traffic {
+    size_t accounts;
+    size_t hot;
+    unsigned hot_percent;
+    Transfer_Engine::Transfer next(bench::Random &rng) const {
+        auto pick = [&] {
+            const uint64_t r = rng.next();
+            return (r % 100 < hot_percent) ? (r >> 32) % hot : (r >> 32) % accounts;
+        };
+        const size_t from = pick();
+        size_t to = pick();
+        if (to == from)
+            to = (to + 1) % accounts;
+        return {from, to, Money::from_cents(static_cast<int64_t>(rng.next() % 10000) + 1)};
+    }
+};
+
+static void open_accounts(Transfer_Engine &engine, size_t count) {
+    for (size_t i = 0; i < count; ++i)
+        engine.add(Account {"Acct-" + to_string(i), Money {1000}});
+}
+
+// Account i is of class i % 4: Account, Savings, Checking, Trust
+static void open_mixed_accounts(Transfer_Engine &engine, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const string name = "Acct-" + to_string(i);
+        switch (i % 4) {
+        case 0: engine.add(Account {name, Money {1000}}); break;
+        case 1: engine.add(Savings_Account {name, Money {1000}, 5.0}); break;
+        case 2: engine.add(Checking_Account {name, Money {1000}}); break;
+        case 3: engine.add(Trust_Account {name, Money {1000}, 5.0}); break;
+        }
+    }
+}
+
+static bool is_checking(size_t id) { return id % 4 == 2; }
+
+static bool check_no_interest() {
+    Transfer_Engine engine {1};
+    const auto a = engine.add(Savings_Account {"Moe", Money {1000}, 5.0});
+    const auto b = engine.add(Savings_Account {"Larry", Money {}, 5.0});
+    const auto trust = engine.add(Trust_Account {"Curly", Money {}, 5.0});
+    bool ok = true;
+    for (int i = 0; i < 20; ++i)
+        ok &= engine.transfer(i % 2 ? b : a, i % 2 ? a : b, Money {1000});
+    ok &= engine.balance(a) == Money {1000} && engine.balance(b) == Money {};
+    const auto rich = engine.add(Account {"Shemp", Money {5000}});
+    ok &= engine.transfer(rich, trust, Money {5000}) && engine.balance(trust) == Money {5000};
+    return bench::report_check("transfers earn no interest or bonus", ok);
+}
+
+static bool check(unsigned workers) {
+    constexpr size_t accounts {1000};
+    const Money fee = Money::from_cents(150);      // Checking_Account per_check_fee
+    Transfer_Engine engine {workers};
+    open_mixed_accounts(engine, accounts);
+    const Traffic traffic {accounts, 4, 50};
+
+    vector<Transfer_Engine::Transfer> batch;
+    bench::Random batch_rng {99};
+    for (int i = 0; i < 200000; ++i)
+        batch.push_back(traffic.next(batch_rng));
+    future<Success_Bitmap> batch_done = engine.submit(batch);
+
+    atomic<size_t> succeeded {0};
+    atomic<size_t> fees_paid {0};
+    vector<thread> clients;
+    for (unsigned t = 0; t < 16; ++t) {
+        clients.emplace_back([&, t] {
+            bench::Random rng {t + 1};
+            size_t ok = 0;
+            size_t fees = 0;
+            for (int i = 0; i < 50000; ++i) {
+                const Transfer_Engine::Transfer tr = traffic.next(rng);
+                if (engine.transfer(tr.from, tr.to, tr.amount)) {
+                    ++ok;
+                    fees += is_checking(tr.from);
+                }
+            }
+            succeeded += ok;
+            fees_paid += fees;
+        });
+    }
+    for (unsigned t = 0; t < 2; ++t) {       // opposite directions over one pair
+        clients.emplace_back([&, t] {
+            for (int i = 0; i < 100000; ++i)
+                engine.transfer(t ? 0 : 1, t ? 1 : 0, Money::from_cents(1));
+        });
+    }
+    for (auto &c : clients)
+        c.join();
+    const Success_Bitmap batch_result = batch_done.get();
+    const size_t batch_ok = batch_result.count();
+    for (size_t i = 0; i < batch.size(); ++i)
+        fees_paid += batch_result.test(i) && is_checking(batch[i].from);
+
+    Money total {};
+    bool negative = false;
+    for (size_t i = 0; i < accounts; ++i) {
+        total += engine.balance(i);
+        negative |= engine.balance(i) < Money {};
+    }
+    const Money fees = fee * static_cast<int64_t>(fees_paid.load());
+    const bool ok = total + fees == Money {1000} * static_cast<int64_t>(accounts) && !negative;
+    cout << "check: " << succeeded.load() << " of 800000 client and " << batch_ok
+         << " of 200000 batch transfers succeeded, total " << total << " + " << fees << " in fees"
+         << (ok ? " (conserved, none negative)" : " (WRONG)") << endl;
+    return ok;
+}
+
+// Synchronous transfers from `threads` clients; prints M transfers/s, p50 and p99 in ns
+static void clients(unsigned threads, const Traffic &traffic, size_t total) {
+    Transfer_Engine engine {1};
+    open_accounts(engine, traffic.accounts);
+    const size_t per_thread = total / threads;
+    vector<vector<float>> latencies(threads);
+    atomic<bool> go {false};
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            bench::Random rng {t + 7};
+            vector<float> &lat = latencies[t];
+            lat.reserve(per_thread);
+            while (!go.load(memory_order_acquire))
+                this_thread::yield();
+            for (size_t i = 0; i < per_thread; ++i) {
+                const Transfer_Engine::Transfer tr = traffic.next(rng);
+                const auto start = chrono::steady_clock::now();
+                engine.transfer(tr.from, tr.to, tr.amount);
+                lat.push_back(chrono::duration<float, nano>(chrono::steady_clock::now() - start).count());
+            }
+        });
+    }
+    bench::Stopwatch sw;
+    go.store(true, memory_order_release);
+    for (auto &w : workers)
+        w.join();
+    const double ns = sw.elapsed_ns();
+
+    vector<float> all;
+    for (auto &lat : latencies)
+        all.insert(all.end(), lat.begin(), lat.end());
+    auto percentile = [&all](double p) {
+        auto nth = all.begin() + static_cast<ptrdiff_t>(p * (all.size() - 1));
+        nth_element(all.begin(), nth, all.end());
+        return *nth;
+    };
+    cout << setw(8) << threads << fixed << setprecision(2) << setw(14) << per_thread * threads / ns * 1e3
+         << setprecision(0) << setw(10) << percentile(0.50) << setw(10) << percentile(0.99) << endl;
+}
+
+// The same work as batches on a pool of `workers`; prints M transfers/s
+static void batches(unsigned workers, const Traffic &traffic, size_t total) {
+    constexpr size_t batch_size {65536};
+    Transfer_Engine engine {workers};
+    open_accounts(engine, traffic.accounts);
+    bench::Random rng {5};
+    vector<vector<Transfer_Engine::Transfer>> work;
+    for (size_t done = 0; done < total; done += batch_size) {
+        work.emplace_back();
+        for (size_t i = 0; i < batch_size; ++i)
+            work.back().push_back(traffic.next(rng));
+    }
+    bench::Stopwatch sw;
+    vector<future<Success_Bitmap>> results;
+    for (auto &batch : work)
+        results.push_back(engine.submit(move(batch)));
+    size_t ok = 0;
+    for (auto &r : results)
+        ok += r.get().count();
+    const double ns = sw.elapsed_ns();
+    bench::do_not_optimize(ok);
+    cout << setw(8) << workers << fixed << setprecision(2) << setw(14) << results.size() * batch_size / ns * 1e3 << endl;
+}
+
+int main() {
+    const unsigned hardware = max(1u, thread::hardware_concurrency());
+    bool ok = check_no_interest();
+    ok &= check(max(4u, hardware));
+
+    constexpr size_t accounts {100000};
+    constexpr size_t total {2000000};
+    const unsigned max_threads = max(8u, hardware);
+    for (unsigned hot_percent : {0u, 50u, 90u}) {
+        const Traffic traffic {accounts, 8, hot_percent};
+        cout << "\nHot-account skew " << hot_percent << "% (" << hardware << " hardware threads)" << endl;
+        cout << " clients  M transfers/s   p50 ns   p99 ns" << endl;
+        for (unsigned threads = 1; threads <= max_threads; threads *= 2)
+            clients(threads, traffic, total);
+        cout << " workers  M transfers/s  (batches of 65536)" << endl;
+        for (unsigned workers = 1; workers <= max_threads; workers *= 2)
+            batches(workers, traffic, total);
+    }
+    return ok ? 0 : 1;
+}
@@ -1,11 +1,11 @@
 #include "Account.h"
 
-Account::Account(std::string name, double balance) 
+Account::Account(std::string name, Money balance) 
     : name{name}, balance{balance} {
 }
 
-bool Account::deposit(double amount) {
-    if (amount < 0) 
+bool Account::deposit(Money amount) {
+    if (amount < Money {}) 
         return false;
     else {
         balance += amount;
@@ -13,8 +13,8 @@ bool Account::deposit(double amount) {
     }
 }
 
-bool Account::withdraw(double amount) {
-    if (balance-amount >=0) {
+bool Account::withdraw(Money amount) {
+    if (amount <= balance) {
         balance-=amount;
         return true;
     } else
@@ -3,18 +3,26 @@
 #define _ACCOUNT_H_
 #include <iostream>
 #include <string>
+#include "Money.h"
 
 class Account {
     friend std::ostream &operator<<(std::ostream &os, const Account &account);
 private:   
     static constexpr const char *def_name = "Unnamed Account";
-    static constexpr double def_balance = 0.0;
+    static constexpr Money def_balance {};
 protected:
     std::string name;
-    double balance;
+    Money balance;
 public:
-    Account(std::string name = def_name, double balance = def_balance);
-    bool deposit(double amount);
-    bool withdraw(double amount);
+    Account(std::string name = def_name, Money balance = def_balance);
+    bool deposit(Money amount);
+    bool withdraw(Money amount);
+
+    const std::string &get_name() const { return name; }
+    Money get_balance() const { return balance; }
+    // Adds delta (possibly negative) to the balance with no rule at all: no
+    // check, fee, interest or bonus. For code that moves money another
+    // account's rules already accepted, undoes a change or replays one.
+    void adjust_balance(Money delta) { balance += delta; }
 };
 #endif
\ No newline at end of file
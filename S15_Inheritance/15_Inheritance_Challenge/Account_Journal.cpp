@@ -0,0 +1,373 @@
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include "Account_Journal.h"
+
+#include <cerrno>
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// ===== Record encoding =====
+
+constexpr std::array<std::uint32_t, 256> crc_table = [] {
+    std::array<std::uint32_t, 256> table {};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t c = i;
+        for (int bit = 0; bit < 8; ++bit)
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        table[i] = c;
+    }
+    return table;
+}();
+
+// CRC-32 (the zlib / PNG one); pass the crc so far to continue it
+std::uint32_t crc32(const char *data, std::size_t size, std::uint32_t crc = 0) {
+    std::uint32_t c = crc ^ 0xFFFFFFFFu;
+    for (std::size_t i = 0; i < size; ++i)
+        c = crc_table[(c ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (c >> 8);
+    return c ^ 0xFFFFFFFFu;
+}
+
+template <typename T>
+void put(char *at, T value) { std::memcpy(at, &value, sizeof value); }
+
+template <typename T>
+T get(const char *at) {
+    T value;
+    std::memcpy(&value, at, sizeof value);
+    return value;
+}
+
+// ===== File access =====
+
+[[noreturn]] void fail(const char *what, const std::string &path = {}) {
+    throw std::runtime_error {std::string {"Account_Journal: "} + what + (path.empty() ? "" : " " + path)};
+}
+
+#ifdef _WIN32
+
+// created tells whether this call made the file (O_EXCL first)
+int open_file(const std::string &path, bool &created) {
+    int fd = _open(path.c_str(), _O_RDWR | _O_CREAT | _O_EXCL | _O_BINARY, _S_IREAD | _S_IWRITE);
+    created = fd >= 0;
+    if (fd < 0 && errno == EEXIST)
+        fd = _open(path.c_str(), _O_RDWR | _O_BINARY);
+    return fd;
+}
+// NTFS journals directory entries itself, and there is no handle to sync
+bool sync_directory(const std::string &) { return true; }
+long long read_some(int fd, char *data, std::size_t size) { return _read(fd, data, static_cast<unsigned>(size)); }
+long long write_some(int fd, const char *data, std::size_t size) { return _write(fd, data, static_cast<unsigned>(size)); }
+bool cut(int fd, std::uint64_t size) { return _chsize_s(fd, static_cast<long long>(size)) == 0; }
+bool seek_end(int fd) { return _lseeki64(fd, 0, SEEK_END) >= 0; }
+bool sync(int fd) { return _commit(fd) == 0; }
+void close_file(int fd) { _close(fd); }
+bool interrupted() { return false; }
+
+#else
+
+// created tells whether this call made the file (O_EXCL first)
+int open_file(const std::string &path, bool &created) {
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    created = fd >= 0;
+    if (fd < 0 && errno == EEXIST)
+        fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+    return fd;
+}
+
+// A new file's name is an entry in its directory, which fsync of the file
+// does not write: until the directory is synced a crash can lose the file
+bool sync_directory(const std::string &path) {
+    const std::size_t slash = path.find_last_of('/');
+    const std::string dir = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+    const int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+    const bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+}
+long long read_some(int fd, char *data, std::size_t size) { return ::read(fd, data, size); }
+long long write_some(int fd, const char *data, std::size_t size) { return ::write(fd, data, size); }
+bool cut(int fd, std::uint64_t size) { return ::ftruncate(fd, static_cast<off_t>(size)) == 0; }
+bool seek_end(int fd) { return ::lseek(fd, 0, SEEK_END) >= 0; }
+#ifdef __linux__
+bool sync(int fd) { return ::fdatasync(fd) == 0; }  // the size is data too; skips the timestamps
+#else
+bool sync(int fd) { return ::fsync(fd) == 0; }
+#endif
+void close_file(int fd) { ::close(fd); }
+bool interrupted() { return errno == EINTR; }
+
+#endif
+
+void write_all(int fd, const char *data, std::size_t size) {
+    while (size != 0) {
+        const long long n = write_some(fd, data, size);
+        if (n < 0 && interrupted())
+            continue;
+        if (n <= 0)
+            fail("cannot write the journal");
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+}
+
+// Opens the journal, creating it if needed; a new journal is made durable
+// (its directory entry synced) before any record can be committed to it
+int open_journal(const std::string &path) {
+    bool created;
+    const int fd = open_file(path, created);
+    if (fd < 0)
+        fail("cannot open", path);
+    if (created && !sync_directory(path)) {
+        close_file(fd);
+        fail("cannot sync the directory of", path);
+    }
+    return fd;
+}
+
+} // namespace
+
+// ===== Account_Journal =====
+
+Account_Journal::Account_Journal(const std::string &path, const std::function<void(const Record &)> &replay)
+    : fd{open_journal(path)}, appended{0}, durable{0}, syncing{false}, failed{false}, sync_count{0} {
+    try {
+        std::vector<char> bytes;
+        char buffer[1 << 16];
+        for (;;) {
+            const long long n = read_some(fd, buffer, sizeof buffer);
+            if (n < 0 && interrupted())
+                continue;
+            if (n < 0)
+                fail("cannot read", path);
+            if (n == 0)
+                break;
+            bytes.insert(bytes.end(), buffer, buffer + n);
+        }
+
+        std::size_t pos = 0;
+        while (bytes.size() - pos >= header_size) {
+            const char *at = bytes.data() + pos;
+            const std::size_t length = header_size + get<std::uint16_t>(at + 6);
+            if (bytes.size() - pos < length
+                || get<std::uint32_t>(at) != crc32(at + 4, length - 4)
+                || get<std::uint8_t>(at + 4) > static_cast<std::uint8_t>(Op::fee)
+                || get<std::uint8_t>(at + 5) > static_cast<std::uint8_t>(Kind::trust))
+                break;              // the partial (or damaged) tail of a crash
+            if (replay) {
+                Record record {static_cast<Op>(get<std::uint8_t>(at + 4)), get<std::uint64_t>(at + 8),
+                               Money::from_cents(get<std::int64_t>(at + 16)), static_cast<Kind>(get<std::uint8_t>(at + 5)),
+                               get<double>(at + 24), std::string {at + header_size, length - header_size}};
+                replay(record);
+            }
+            pos += length;
+        }
+        if (pos != bytes.size() && !cut(fd, pos))
+            fail("cannot cut the partial record from", path);
+        if (!seek_end(fd))
+            fail("cannot seek in", path);
+        appended = durable = pos;
+    } catch (...) {
+        close_file(fd);
+        throw;
+    }
+}
+
+Account_Journal::~Account_Journal() {
+    try {
+        commit(appended);
+    } catch (const std::runtime_error &) {
+        // nothing more can be done from a destructor
+    }
+    close_file(fd);
+}
+
+std::uint64_t Account_Journal::append(const Record &record) {
+    const std::size_t name_length = record.op == Op::open ? record.name.size() : 0;
+    if (name_length > 0xFFFF)
+        throw std::length_error {"Account_Journal: account name too long"};
+    char bytes[header_size];
+    put(bytes + 4, static_cast<std::uint8_t>(record.op));
+    put(bytes + 5, static_cast<std::uint8_t>(record.kind));
+    put(bytes + 6, static_cast<std::uint16_t>(name_length));
+    put(bytes + 8, record.account_id);
+    put(bytes + 16, record.amount.in_cents());
+    put(bytes + 24, record.int_rate);
+    put(bytes, crc32(record.name.data(), name_length, crc32(bytes + 4, header_size - 4)));
+
+    std::lock_guard<std::mutex> guard {lock};
+    if (failed)
+        fail("an earlier write or sync failed");
+    pending.insert(pending.end(), bytes, bytes + header_size);
+    pending.insert(pending.end(), record.name.data(), record.name.data() + name_length);
+    appended += header_size + name_length;
+    return appended;
+}
+
+// The caller that finds no sync in progress becomes the leader: it takes
+// everything buffered so far, writes and syncs it without holding the
+// lock (appends carry on meanwhile), then wakes the waiters. A waiter
+// whose record missed that sync leads the next one.
+//
+// A failed write or sync loses the batch (and may leave part of it in the
+// file, which replay cuts off), so nothing after durable can be promised
+// any more: the journal is marked failed and every waiting and later
+// append or commit throws.
+void Account_Journal::commit(std::uint64_t position) {
+    std::unique_lock<std::mutex> guard {lock};
+    while (durable < position) {
+        if (failed)
+            fail("an earlier write or sync failed");
+        if (syncing) {
+            synced.wait(guard);
+            continue;
+        }
+        syncing = true;
+        std::vector<char> batch;
+        batch.swap(pending);
+        const std::uint64_t target = appended;
+        guard.unlock();
+        bool ok = true;
+        try {
+            write_all(fd, batch.data(), batch.size());
+            ok = sync(fd);
+        } catch (const std::runtime_error &) {
+            ok = false;
+        }
+        guard.lock();
+        syncing = false;
+        if (ok) {
+            durable = target;
+            ++sync_count;
+        } else {
+            failed = true;
+        }
+        synced.notify_all();
+        if (!ok)
+            fail("cannot write and sync the journal");
+    }
+}
+
+std::uint64_t Account_Journal::syncs() {
+    std::lock_guard<std::mutex> guard {lock};
+    return sync_count;
+}
+
+// ===== Journaled_Accounts =====
+
+Journaled_Accounts::Journaled_Accounts(const std::string &path)
+    : recovered{0}, journal{path, [this](const Account_Journal::Record &record) { apply(record); }} {
+}
+
+// Replays one record straight into the fields: the effects were worked
+// out by the class rules when they were journaled
+void Journaled_Accounts::apply(const Account_Journal::Record &record) {
+    using Op = Account_Journal::Op;
+    using Kind = Account_Journal::Kind;
+    if (record.op == Op::open) {
+        if (record.account_id != accounts.size())
+            throw std::runtime_error {"Account_Journal: records out of order"};
+        switch (record.kind) {
+        case Kind::account:  accounts.add(Account {record.name, record.amount}); break;
+        case Kind::savings:  accounts.add(Savings_Account {record.name, record.amount, record.int_rate}); break;
+        case Kind::checking: accounts.add(Checking_Account {record.name, record.amount}); break;
+        case Kind::trust:    accounts.add(Trust_Account {record.name, record.amount, record.int_rate}); break;
+        }
+    } else {
+        if (record.account_id >= accounts.size())
+            throw std::runtime_error {"Account_Journal: record for an account never opened"};
+        std::visit([&record](auto &account) {
+            account.adjust_balance(record.op == Op::deposit ? record.amount : -record.amount);
+            if constexpr (std::is_same_v<std::decay_t<decltype(account)>, Trust_Account>)
+                if (record.op == Op::withdrawal)
+                    account.set_num_withdrawals(account.get_num_withdrawals() + 1);
+        }, accounts[record.account_id].account);
+    }
+    ++recovered;
+}
+
+template <typename T>
+Journaled_Accounts::Account_id Journaled_Accounts::add_slot(const T &account, Account_Journal::Kind kind, double int_rate) {
+    const Account_id id = accounts.size();
+    std::uint64_t position = journal.append({Account_Journal::Op::open, id, account.get_balance(), kind, int_rate, account.get_name()});
+    accounts.add(account);
+    if constexpr (std::is_same_v<T, Trust_Account>) {
+        // withdrawals made before the account was added still count
+        for (int i = 0; i < account.get_num_withdrawals(); ++i)
+            position = journal.append({Account_Journal::Op::withdrawal, id, Money {}});
+    }
+    journal.commit(position);
+    return id;
+}
+
+Journaled_Accounts::Account_id Journaled_Accounts::add(const Account &account) {
+    return add_slot(account, Account_Journal::Kind::account, 0.0);
+}
+
+Journaled_Accounts::Account_id Journaled_Accounts::add(const Savings_Account &account) {
+    return add_slot(account, Account_Journal::Kind::savings, account.get_int_rate());
+}
+
+Journaled_Accounts::Account_id Journaled_Accounts::add(const Checking_Account &account) {
+    return add_slot(account, Account_Journal::Kind::checking, 0.0);
+}
+
+Journaled_Accounts::Account_id Journaled_Accounts::add(const Trust_Account &account) {
+    return add_slot(account, Account_Journal::Kind::trust, account.get_int_rate());
+}
+
+// The record is appended while the account is locked, so the journal has
+// each account's changes in the order they were made; the sync happens
+// after the lock is released, so other accounts are not held up by it.
+bool Journaled_Accounts::deposit(Account_id id, Money amount) {
+    Slot &s = accounts.at(id);
+    std::uint64_t position;
+    {
+        std::lock_guard<std::mutex> guard {s.lock};
+        Account &account = std::visit([](auto &acc) -> Account & { return acc; }, s.account);
+        const Money before = account.get_balance();
+        if (!std::visit([amount](auto &acc) { return acc.deposit(amount); }, s.account))
+            return false;
+        position = journal.append({Account_Journal::Op::deposit, id, account.get_balance() - before});
+    }
+    journal.commit(position);
+    return true;
+}
+
+// A withdrawal is journaled as the amount taken plus, separately, any fee
+// (the rest of the balance change); a refused Trust withdrawal that was
+// still counted is journaled as a withdrawal of 0.
+bool Journaled_Accounts::withdraw(Account_id id, Money amount) {
+    Slot &s = accounts.at(id);
+    std::uint64_t position;
+    bool ok;
+    {
+        std::lock_guard<std::mutex> guard {s.lock};
+        Account &account = std::visit([](auto &acc) -> Account & { return acc; }, s.account);
+        const Trust_Account *trust = std::get_if<Trust_Account>(&s.account);
+        const Money before = account.get_balance();
+        const int count_before = trust ? trust->get_num_withdrawals() : 0;
+        ok = std::visit([amount](auto &acc) { return acc.withdraw(amount); }, s.account);
+        if (!ok && !(trust && trust->get_num_withdrawals() != count_before))
+            return false;
+        const Money taken = ok ? amount : Money {};
+        const Money fee = before - account.get_balance() - taken;
+        position = journal.append({Account_Journal::Op::withdrawal, id, taken});
+        if (fee != Money {})
+            position = journal.append({Account_Journal::Op::fee, id, fee});
+    }
+    journal.commit(position);
+    return ok;
+}
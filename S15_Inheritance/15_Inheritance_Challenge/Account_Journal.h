@@ -0,0 +1,135 @@
+// Account_Journal: a write-ahead journal so accounts survive a restart
+//
+// Account state only lives in memory. Journaled_Accounts owns a set of
+// accounts (any class of the hierarchy, identified by the id add()
+// returns) and records the effect of every operation in an append-only
+// binary file before the caller is told it happened:
+//   open       : id, class, starting balance, int_rate and name
+//   deposit    : id, amount credited (interest and Trust bonus included)
+//   withdrawal : id, amount debited (0 for a refused Trust withdrawal
+//                that still counts against its 3 per year)
+//   fee        : id, Checking_Account per_check_fee
+// Replaying those effects (not the requests) rebuilds every balance and
+// Trust withdrawal count exactly, even if the rules change later.
+//
+// Record layout (little-endian, 32 bytes + the name for open):
+//   0 crc32 of bytes 4.. | 4 op | 5 class | 6 name length | 8 account id
+//   16 cents | 24 int_rate | 32 name
+// A crash can leave a partial last record; replay stops at the first
+// record that is short or fails its checksum and the journal is cut
+// back to there before new records are appended.
+//
+// Group commit: fsync is by far the slowest step, so appends only copy
+// the record into a buffer. The first caller that needs its record on
+// disk writes and syncs everything buffered so far, and the callers
+// that arrive meanwhile wait and share the next sync.
+//
+//   Journaled_Accounts bank {"accounts.journal"};     // replays the file
+//   auto id = bank.add(Trust_Account {"Moe", 10000, 2.0});
+//   bank.deposit(id, 5000);                            // durable on return
+//
+// Accounts must all be added before other threads start using them
+// (see Locked_Accounts.h).
+#ifndef _ACCOUNT_JOURNAL_H_
+#define _ACCOUNT_JOURNAL_H_
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Money.h"
+#include "Account.h"
+#include "Savings_Account.h"
+#include "Checking_Account.h"
+#include "Trust_Account.h"
+#include "Account_Ledger.h"
+#include "Locked_Accounts.h"
+
+class Account_Journal {
+public:
+    using Kind = Account_Ledger::Kind;
+    enum class Op : std::uint8_t { open, deposit, withdrawal, fee };
+
+    struct Record {
+        Op op;
+        std::uint64_t account_id;
+        Money amount;               // the starting balance for open
+        Kind kind {Kind::account};  // open only
+        double int_rate {0.0};      // open only
+        std::string name {};        // open only
+    };
+
+    static constexpr std::size_t header_size = 32;
+private:
+    int fd;
+    std::mutex lock;
+    std::condition_variable synced;
+    std::vector<char> pending;      // appended, not yet written
+    std::uint64_t appended;         // journal size once pending is written
+    std::uint64_t durable;          // bytes known to be on disk
+    bool syncing;
+    bool failed;                    // a write or sync failed: nothing more can be made durable
+    std::uint64_t sync_count;
+public:
+    // Opens or creates the journal at path (a new file's directory is synced,
+    // so the file itself survives a crash). Existing records are passed to
+    // replay in order, then a partial last record (if any) is cut off.
+    // Throws std::runtime_error when the file cannot be opened or read.
+    explicit Account_Journal(const std::string &path,
+                             const std::function<void(const Record &)> &replay = {});
+    ~Account_Journal();             // writes and syncs whatever is still buffered
+    Account_Journal(const Account_Journal &) = delete;
+    Account_Journal &operator=(const Account_Journal &) = delete;
+
+    // Buffers a record; returns its position to pass to commit. Thread-safe.
+    // Throws std::runtime_error once a write or sync has failed.
+    std::uint64_t append(const Record &record);
+
+    // Returns once everything up to position is on disk (group commit).
+    // Throws std::runtime_error when the write or the sync fails, and from
+    // then on for every commit that is not already durable.
+    void commit(std::uint64_t position);
+
+    std::uint64_t syncs();          // how many syncs commit has done (records per sync shows the batching)
+};
+
+class Journaled_Accounts {
+public:
+    using Account_id = std::uint64_t;
+private:
+    using Slot = Locked_Accounts::Slot;
+    Locked_Accounts accounts;
+    std::size_t recovered;          // records replayed at startup
+    Account_Journal journal;        // declared last: its constructor replays into accounts
+
+    void apply(const Account_Journal::Record &record);
+    template <typename T>
+    Account_id add_slot(const T &account, Account_Journal::Kind kind, double int_rate);
+public:
+    // Rebuilds the accounts recorded in the journal at path (if any), then
+    // journals every change from here on
+    explicit Journaled_Accounts(const std::string &path);
+
+    Account_id add(const Account &account);
+    Account_id add(const Savings_Account &account);
+    Account_id add(const Checking_Account &account);
+    Account_id add(const Trust_Account &account);
+
+    // As the account's own deposit/withdraw; safe to call from any thread.
+    // The change is on disk when these return. If a write or sync fails they
+    // throw std::runtime_error, memory is ahead of the journal, and every
+    // later call throws too: reopen the journal to get back to what is on disk.
+    bool deposit(Account_id id, Money amount);
+    bool withdraw(Account_id id, Money amount);
+
+    std::size_t size() const { return accounts.size(); }
+    std::size_t records_recovered() const { return recovered; }
+    std::uint64_t journal_syncs() { return journal.syncs(); }
+    Money balance(Account_id id) const { return accounts.balance(id); }
+    void display(std::ostream &os, Account_id id) const { accounts.display(os, id); }   // as the account's own operator<<
+};
+
+#endif // _ACCOUNT_JOURNAL_H_
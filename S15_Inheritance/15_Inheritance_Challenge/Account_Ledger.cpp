@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "Account_Ledger.h"
+
+Success_Bitmap::Success_Bitmap(std::size_t bits)
+    : words((bits + 63) / 64, 0), bits{bits} {
+}
+
+std::size_t Success_Bitmap::count() const {
+    std::size_t total = 0;
+    for (std::uint64_t w: words)
+        total += static_cast<std::size_t>(__builtin_popcountll(w));
+    return total;
+}
+
+namespace {
+
+// a + b as Money would compute it; overflow is set instead of throwing.
+// Plain integer operations, so the batch loops still vectorize.
+inline std::int64_t add_cents(std::int64_t a, std::int64_t b, bool &overflow) {
+    const std::int64_t sum = static_cast<std::int64_t>(static_cast<std::uint64_t>(a) + static_cast<std::uint64_t>(b));
+    overflow |= ((a ^ sum) & (b ^ sum)) < 0;
+    return sum;
+}
+
+// a - b, likewise
+inline std::int64_t sub_cents(std::int64_t a, std::int64_t b, bool &overflow) {
+    const std::int64_t diff = static_cast<std::int64_t>(static_cast<std::uint64_t>(a) - static_cast<std::uint64_t>(b));
+    overflow |= ((a ^ b) & (a ^ diff)) < 0;
+    return diff;
+}
+
+// AVX2 has no packed int64 <-> double conversions, and g++ will not
+// vectorize a loop with cvtsi2sd / cvttsd2si, std::trunc or a select on a
+// double compare. The helpers below convert through the bits instead:
+// adding 1.5 * 2^52 to 0 <= y < 2^51 leaves round(y) in the low mantissa
+// bits, and an int64 is split into 32-bit halves that each fit exactly.
+inline std::uint64_t bits_of(double d) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &d, sizeof bits);
+    return bits;
+}
+
+inline double from_bits(std::uint64_t bits) {
+    double d;
+    std::memcpy(&d, &bits, sizeof d);
+    return d;
+}
+
+constexpr double magic = 0x1.8p52;
+
+inline double nearest(double y) { return (y + magic) - magic; }        // 0 <= y < 2^51
+inline std::uint64_t small_to_int(double y) { return bits_of(y + magic) - bits_of(magic); }
+inline double int_to_small(std::uint64_t u) { return from_bits(u + bits_of(magic)) - magic; }
+
+// static_cast<double>(v): the high half (sign included) and the low half
+// are exact, and their sum rounds once
+inline double to_double(std::int64_t v) {
+    const std::uint64_t u = static_cast<std::uint64_t>(v);
+    const double high = from_bits((u >> 32) ^ 0x4530000080000000) - from_bits(0x4530000080100000);
+    const double low = from_bits((u & 0xFFFFFFFF) | 0x4330000000000000);
+    return high + low;
+}
+
+// Money::percent: rate percent of cents, rounded half away from zero.
+// Same result as std::round: the magnitude is split at 2^32, each part is
+// floored, and the remainder (exact in double) decides the last step.
+// Selects happen on integers (the bits of a non-negative double, NaN
+// included, order like its value). On overflow the result is meaningless.
+inline std::int64_t percent_cents(std::int64_t cents, double rate, bool &overflow) {
+    const std::uint64_t bits = bits_of(to_double(cents) * (rate / 100));
+    const std::uint64_t limit = bits_of(0x1p63);
+    const bool negative = bits >> 63;
+    const std::uint64_t magnitude_bits = bits & 0x7FFFFFFFFFFFFFFF;
+    overflow |= (magnitude_bits > limit) | ((magnitude_bits == limit) & !negative);
+    const double magnitude = from_bits(std::min(magnitude_bits, limit));
+    const double scaled = magnitude * 0x1p-32;                          // [0, 2^31]
+    const std::uint64_t high = small_to_int(scaled) - (nearest(scaled) > scaled);
+    const double low = magnitude - int_to_small(high) * 0x1p32;         // [0, 2^32), exact
+    const std::uint64_t whole = small_to_int(low) - (nearest(low) > low);
+    const std::uint64_t rounded = (high << 32) + whole + (low - int_to_small(whole) >= 0.5);
+    const std::uint64_t sign = 0 - static_cast<std::uint64_t>(negative);
+    return static_cast<std::int64_t>((rounded ^ sign) - sign);
+}
+
+// What a deposit of amount credits: Trust accounts add bonus_amount to
+// deposits of bonus_threshold or more, then amount * rate/100 is added,
+// rounded to the cent. ok is cleared when the deposit fails: a negative
+// credit (as in Account::deposit) or a Money overflow.
+inline std::int64_t deposit_credit(std::int64_t amount, bool trust, double rate, bool &ok) {
+    constexpr std::int64_t bonus_threshold = Trust_Account::bonus_threshold.in_cents();
+    constexpr std::int64_t bonus_amount = Trust_Account::bonus_amount.in_cents();
+    bool overflow = false;
+    amount = add_cents(amount, (trust & (amount >= bonus_threshold)) ? bonus_amount : 0, overflow);
+    amount = add_cents(amount, percent_cents(amount, rate, overflow), overflow);
+    ok &= (amount >= 0) & !overflow;
+    return amount;
+}
+
+} // namespace
+
+void Account_Ledger::reserve(std::size_t count) {
+    names.reserve(count);
+    balances.reserve(count);
+    int_rates.reserve(count);
+    rate_ids.reserve(count);
+    withdrawals.reserve(count);
+    kinds.reserve(count);
+}
+
+void Account_Ledger::add(const std::string &name, Kind kind, Money balance, double int_rate, int num_withdrawals) {
+    names.push_back(name);
+    kinds.push_back(kind);
+    balances.push_back(balance.in_cents());
+    int_rates.push_back(int_rate);
+    rate_ids.push_back(rate_id(int_rate));
+    withdrawals.push_back(num_withdrawals);
+}
+
+// Index of int_rate in rates, appending it the first time it is seen
+std::uint32_t Account_Ledger::rate_id(double int_rate) {
+    const auto found = rate_index.try_emplace(bits_of(int_rate), static_cast<std::uint32_t>(rates.size()));
+    if (found.second)
+        rates.push_back(int_rate);
+    return found.first->second;
+}
+
+void Account_Ledger::add(const Account &account) {
+    add(account.get_name(), Kind::account, account.get_balance(), 0.0, 0);
+}
+
+void Account_Ledger::add(const Savings_Account &account) {
+    add(account.get_name(), Kind::savings, account.get_balance(), account.get_int_rate(), 0);
+}
+
+void Account_Ledger::add(const Checking_Account &account) {
+    add(account.get_name(), Kind::checking, account.get_balance(), 0.0, 0);
+}
+
+void Account_Ledger::add(const Trust_Account &account) {
+    add(account.get_name(), Kind::trust, account.get_balance(), account.get_int_rate(), account.get_num_withdrawals());
+}
+
+// Deposit:
+//      Every account adds credit_at(i, ok), the result of deposit_credit
+//      for its amount, class and rate, unless that clears ok.
+//
+// Every rule is a select and each block of 64 accounts yields one word of
+// the bitmap. With -O3 -mavx2 the loop vectorizes for both kinds of
+// credit_at: a lookup in a table, or deposit_credit itself, whose
+// interest rounding is written to vectorize.
+template <typename Credits>
+Success_Bitmap Account_Ledger::deposit_batch(Credits credit_at) {
+    const std::size_t n = size();
+    Success_Bitmap result {n};
+    std::int64_t *balance = balances.data();
+    for (std::size_t base = 0; base < n; base += 64) {
+        const std::size_t end = std::min(n, base + 64);
+        std::uint64_t word = 0;
+        for (std::size_t i = base; i < end; ++i) {
+            bool overflow = false;
+            bool ok = true;
+            const std::int64_t credit = credit_at(i, ok);
+            const std::int64_t new_balance = add_cents(balance[i], credit, overflow);
+            ok &= !overflow;
+            balance[i] = ok ? new_balance : balance[i];
+            word |= static_cast<std::uint64_t>(ok) << (i - base);
+        }
+        result.words[base / 64] = word;
+    }
+    return result;
+}
+
+// Withdraw:
+//      Trust accounts first check the withdrawal limit and the percentage
+//      cap, amount * 100 > balance * max_withdraw_percent (and count the
+//      attempt when both pass, as Trust_Account does); checking accounts
+//      add per_check_fee. The withdrawal then succeeds when the amount
+//      does not exceed the balance.
+template <typename Amounts>
+Success_Bitmap Account_Ledger::withdraw_batch(Amounts amount_at) {
+    const std::size_t n = size();
+    Success_Bitmap result {n};
+    std::int64_t *balance = balances.data();
+    std::int32_t *count = withdrawals.data();
+    const Kind *kind = kinds.data();
+    const std::int64_t fee = Checking_Account::per_check_fee.in_cents();
+    constexpr std::int64_t cap_percent = Trust_Account::max_withdraw_percent;
+    // Beyond these the cap products would overflow (Money would throw):
+    // the operands are clamped and the account fails instead
+    constexpr std::int64_t max_amount = INT64_MAX / 100;
+    constexpr std::int64_t max_balance = INT64_MAX / cap_percent;
+    for (std::size_t base = 0; base < n; base += 64) {
+        const std::size_t end = std::min(n, base + 64);
+        std::uint64_t word = 0;
+        for (std::size_t i = base; i < end; ++i) {
+            bool overflow = false;
+            std::int64_t amount = amount_at(i);
+            const bool trust = kind[i] == Kind::trust;
+            const std::int64_t capped_amount = std::min(std::max(amount, -max_amount), max_amount);
+            const std::int64_t capped_balance = std::min(std::max(balance[i], -max_balance), max_balance);
+            const bool in_range = (capped_amount == amount) & (capped_balance == balance[i]);
+            const std::int64_t scaled_amount = capped_amount * 100;
+            const std::int64_t scaled_cap = capped_balance * cap_percent;
+            const bool within_limits = (count[i] < Trust_Account::max_withdrawals) & !(scaled_amount > scaled_cap);
+            overflow |= trust & !in_range;
+            const bool allowed = (!trust) | within_limits;
+            count[i] += trust & within_limits & in_range;
+            amount = add_cents(amount, (kind[i] == Kind::checking) ? fee : 0, overflow);
+            const std::int64_t new_balance = sub_cents(balance[i], amount, overflow);
+            const bool ok = allowed & (amount <= balance[i]) & !overflow;
+            balance[i] = ok ? new_balance : balance[i];
+            word |= static_cast<std::uint64_t>(ok) << (i - base);
+        }
+        result.words[base / 64] = word;
+    }
+    return result;
+}
+
+// The credit depends only on the rate and whether the account is a Trust,
+// so it is worked out once per distinct rate and the loop over the
+// accounts is integer-only: credits[2 * rate id + trust], -1 for a deposit
+// that fails (a credit is never negative)
+Success_Bitmap Account_Ledger::deposit(Money amount) {
+    std::vector<std::int64_t> credits(rates.size() * 2);
+    for (std::size_t r = 0; r < credits.size(); ++r) {
+        bool ok = true;
+        const std::int64_t credit = deposit_credit(amount.in_cents(), r % 2, rates[r / 2], ok);
+        credits[r] = ok ? credit : -1;
+    }
+    const std::int64_t *credit = credits.data();
+    const std::uint32_t *id = rate_ids.data();
+    const Kind *kind = kinds.data();
+    return deposit_batch([credit, id, kind](std::size_t i, bool &ok) {
+        const std::int64_t c = credit[2 * std::size_t {id[i]} + (kind[i] == Kind::trust)];
+        ok = c >= 0;
+        return c;
+    });
+}
+
+Success_Bitmap Account_Ledger::withdraw(Money amount) {
+    const std::int64_t cents = amount.in_cents();
+    return withdraw_batch([cents](std::size_t) { return cents; });
+}
+
+Success_Bitmap Account_Ledger::deposit(const std::vector<Money> &amounts) {
+    if (amounts.size() != size())
+        throw std::invalid_argument {"Account_Ledger::deposit: one amount per account expected"};
+    const Money *a = amounts.data();
+    const double *rate = int_rates.data();
+    const Kind *kind = kinds.data();
+    return deposit_batch([a, rate, kind](std::size_t i, bool &ok) {
+        return deposit_credit(a[i].in_cents(), kind[i] == Kind::trust, rate[i], ok);
+    });
+}
+
+Success_Bitmap Account_Ledger::withdraw(const std::vector<Money> &amounts) {
+    if (amounts.size() != size())
+        throw std::invalid_argument {"Account_Ledger::withdraw: one amount per account expected"};
+    const Money *a = amounts.data();
+    return withdraw_batch([a](std::size_t i) { return a[i].in_cents(); });
+}
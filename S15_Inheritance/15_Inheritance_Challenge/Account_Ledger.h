@@ -0,0 +1,96 @@
+// Account_Ledger: the Account hierarchy stored column by column
+//
+// Account_Util applies deposit/withdraw one object at a time and prints a
+// line per account. For nightly batches over millions of accounts the
+// ledger keeps each field in its own contiguous array (structure of
+// arrays) and applies a whole batch in one branch-free loop the compiler
+// can vectorize. Each account keeps the rules of its class:
+//   Account          : plain deposit / withdraw
+//   Savings_Account  : deposits earn int_rate percent
+//   Checking_Account : every withdrawal costs per_check_fee
+//   Trust_Account    : deposit bonus, at most max_withdrawals withdrawals,
+//                      each at most max_withdraw_percent of the balance
+// Balances are stored as whole cents (see Money.h), so batch arithmetic is
+// exact. Batch operations print nothing; they return a Success_Bitmap
+// with one bit per account. Where a Money operation would throw
+// std::overflow_error, the ledger fails that account's operation instead
+// and leaves its balance unchanged.
+#ifndef _ACCOUNT_LEDGER_H_
+#define _ACCOUNT_LEDGER_H_
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Money.h"
+#include "Account.h"
+#include "Savings_Account.h"
+#include "Checking_Account.h"
+#include "Trust_Account.h"
+
+// Bit i is set when the operation on account i succeeded
+class Success_Bitmap {
+    friend class Account_Ledger;
+private:
+    std::vector<std::uint64_t> words;
+    std::size_t bits;
+public:
+    explicit Success_Bitmap(std::size_t bits = 0);
+    std::size_t size() const { return bits; }
+    bool test(std::size_t i) const { return (words[i / 64] >> (i % 64)) & 1; }
+    std::size_t count() const;      // number of successful operations
+    const std::vector<std::uint64_t> &data() const { return words; }
+    // Sets bits [64 * index, 64 * index + 64) at once; bits past size() must be 0
+    void set_word(std::size_t index, std::uint64_t word) { words[index] = word; }
+};
+
+class Account_Ledger {
+public:
+    enum class Kind : std::uint8_t { account, savings, checking, trust };
+private:
+    std::vector<std::string> names;
+    std::vector<std::int64_t> balances;     // cents
+    std::vector<double> int_rates;          // 0 for Account and Checking_Account
+    std::vector<std::uint32_t> rate_ids;    // int_rates[i] == rates[rate_ids[i]]
+    std::vector<double> rates;              // each distinct int_rate once
+    std::unordered_map<std::uint64_t, std::uint32_t> rate_index;   // bits of a rate -> its index in rates
+    std::vector<std::int32_t> withdrawals;  // counted for Trust_Account only
+    std::vector<Kind> kinds;
+
+    void add(const std::string &name, Kind kind, Money balance, double int_rate, int num_withdrawals);
+    std::uint32_t rate_id(double int_rate);
+
+    template <typename Credits>
+    Success_Bitmap deposit_batch(Credits credit_at);
+    template <typename Amounts>
+    Success_Bitmap withdraw_batch(Amounts amount_at);
+public:
+    void reserve(std::size_t count);
+    void add(const Account &account);
+    void add(const Savings_Account &account);
+    void add(const Checking_Account &account);
+    void add(const Trust_Account &account);
+    template <typename T>
+    void add(const std::vector<T> &accounts) {
+        reserve(size() + accounts.size());
+        for (const auto &acc: accounts)
+            add(acc);
+    }
+
+    std::size_t size() const { return names.size(); }
+    const std::string &name(std::size_t i) const { return names[i]; }
+    Money balance(std::size_t i) const { return Money::from_cents(balances[i]); }
+    double int_rate(std::size_t i) const { return int_rates[i]; }
+    int num_withdrawals(std::size_t i) const { return withdrawals[i]; }
+    Kind kind(std::size_t i) const { return kinds[i]; }
+
+    // The same amount to/from every account
+    Success_Bitmap deposit(Money amount);
+    Success_Bitmap withdraw(Money amount);
+
+    // amounts[i] to/from account i (throws std::invalid_argument on a size mismatch)
+    Success_Bitmap deposit(const std::vector<Money> &amounts);
+    Success_Bitmap withdraw(const std::vector<Money> &amounts);
+};
+
+#endif // _ACCOUNT_LEDGER_H_
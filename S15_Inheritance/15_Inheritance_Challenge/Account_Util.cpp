@@ -9,7 +9,7 @@ void display(const std::vector<Account> &accounts) {
 }
 
 // Deposits supplied amount to each Account object in the vector
-void deposit(std::vector<Account> &accounts, double amount) {
+void deposit(std::vector<Account> &accounts, Money amount) {
     std::cout << "\n=== Depositing to Accounts =================================" << std::endl;
     for (auto &acc:accounts)  {
         if (acc.deposit(amount)) 
@@ -20,7 +20,7 @@ void deposit(std::vector<Account> &accounts, double amount) {
 }
 
 // Withdraw amount from each Account object in the vector
-void withdraw(std::vector<Account> &accounts, double amount) {
+void withdraw(std::vector<Account> &accounts, Money amount) {
     std::cout << "\n=== Withdrawing from Accounts ==============================" <<std::endl;
     for (auto &acc:accounts)  {
         if (acc.withdraw(amount)) 
@@ -40,7 +40,7 @@ void display(const std::vector<Savings_Account> &accounts) {
 }
 
 // Deposits supplied amount to each Savings Account object in the vector
-void deposit(std::vector<Savings_Account> &accounts, double amount) {
+void deposit(std::vector<Savings_Account> &accounts, Money amount) {
     std::cout << "\n=== Depositing to Savings Accounts===========================" << std::endl;
     for (auto &acc:accounts)  {
         if (acc.deposit(amount)) 
@@ -51,7 +51,7 @@ void deposit(std::vector<Savings_Account> &accounts, double amount) {
 }
 
 // Withdraw supplied amount from each Savings Account object in the vector
-void withdraw(std::vector<Savings_Account> &accounts, double amount) {
+void withdraw(std::vector<Savings_Account> &accounts, Money amount) {
     std::cout << "\n=== Withdrawing from Savings Accounts=======================" << std::endl;
     for (auto &acc:accounts)  {
         if (acc.withdraw(amount)) 
@@ -71,7 +71,7 @@ void display(const std::vector<Checking_Account> &accounts) {
 }
 
 // Deposits supplied amount to each Checking Account object in the vector
-void deposit(std::vector<Checking_Account> &accounts, double amount) {
+void deposit(std::vector<Checking_Account> &accounts, Money amount) {
     std::cout << "\n=== Depositing to Checking Accounts===========================" << std::endl;
     for (auto &acc:accounts)  {
         if (acc.deposit(amount)) 
@@ -82,7 +82,7 @@ void deposit(std::vector<Checking_Account> &accounts, double amount) {
 }
 
 // Withdraw supplied amount from each Checking Account object in the vector
-void withdraw(std::vector<Checking_Account> &accounts, double amount) {
+void withdraw(std::vector<Checking_Account> &accounts, Money amount) {
     std::cout << "\n=== Withdrawing from Checking Accounts=======================" << std::endl;
     for (auto &acc:accounts)  {
         if (acc.withdraw(amount)) 
@@ -102,7 +102,7 @@ void display(const std::vector<Trust_Account> &accounts) {
 }
 
 // Deposits supplied amount to each Trust Account object in the vector
-void deposit(std::vector<Trust_Account> &accounts, double amount) {
+void deposit(std::vector<Trust_Account> &accounts, Money amount) {
     std::cout << "\n=== Depositing to Trust Accounts===========================" << std::endl;
     for (auto &acc:accounts)  {
         if (acc.deposit(amount)) 
@@ -113,7 +113,7 @@ void deposit(std::vector<Trust_Account> &accounts, double amount) {
 }
 
 // Withdraw supplied amount from each Trust Account object in the vector
-void withdraw(std::vector<Trust_Account> &accounts, double amount) {
+void withdraw(std::vector<Trust_Account> &accounts, Money amount) {
     std::cout << "\n=== Withdrawing from Trust Accounts=======================" << std::endl;
     for (auto &acc:accounts)  {
         if (acc.withdraw(amount)) 
@@ -121,4 +121,38 @@ void withdraw(std::vector<Trust_Account> &accounts, double amount) {
         else
             std::cout << "Failed Withdrawal of " << amount << " from " << acc << std::endl;
     } 
-}
\ No newline at end of file
+}
+
+// Helper functions for Account_Ledger
+
+// Displays every account in the ledger in the format of its class
+void display(const Account_Ledger &ledger) {
+    std::cout << "\n=== Ledger Accounts=====================================" << std::endl;
+    for (std::size_t i = 0; i < ledger.size(); ++i) {
+        switch (ledger.kind(i)) {
+        case Account_Ledger::Kind::account:
+            std::cout << "[Account: " << ledger.name(i) << ": " << ledger.balance(i) << "]";
+            break;
+        case Account_Ledger::Kind::savings:
+            std::cout << "[Savings_Account: " << ledger.name(i) << ": " << ledger.balance(i) << ", "
+                      << ledger.int_rate(i) << "]";
+            break;
+        case Account_Ledger::Kind::checking:
+            std::cout << "[Checking_Account: " << ledger.name(i) << ": " << ledger.balance(i) << "]";
+            break;
+        case Account_Ledger::Kind::trust:
+            std::cout << "[Trust Account: " << ledger.name(i) << ": " << ledger.balance(i) << ", "
+                      << ledger.int_rate(i) << "%, withdrawals: " << ledger.num_withdrawals(i) << "]";
+            break;
+        }
+        std::cout << std::endl;
+    }
+}
+
+// Displays a batch result as one character per account: + succeeded, - failed
+void display(const Success_Bitmap &results, const char *operation) {
+    std::cout << operation << ": " << results.count() << " of " << results.size() << " succeeded  ";
+    for (std::size_t i = 0; i < results.size(); ++i)
+        std::cout << (results.test(i) ? '+' : '-');
+    std::cout << std::endl;
+}
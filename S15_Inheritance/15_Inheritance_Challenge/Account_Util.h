@@ -5,27 +5,33 @@
 #include "Savings_Account.h"
 #include "Checking_Account.h"
 #include "Trust_Account.h"
+#include "Account_Ledger.h"
 
 // Utility helper functions for Account class
 
 void display(const std::vector<Account> &accounts);
-void deposit(std::vector<Account> &accounts, double amount);
-void withdraw(std::vector<Account> &accounts, double amount);
+void deposit(std::vector<Account> &accounts, Money amount);
+void withdraw(std::vector<Account> &accounts, Money amount);
 
 // Utility helper functions for Savings Account class
 
 void display(const std::vector<Savings_Account> &accounts);
-void deposit(std::vector<Savings_Account> &accounts, double amount);
-void withdraw(std::vector<Savings_Account> &accounts, double amount);
+void deposit(std::vector<Savings_Account> &accounts, Money amount);
+void withdraw(std::vector<Savings_Account> &accounts, Money amount);
 
 // Utility helper functions for Checking Account class
 void display(const std::vector<Checking_Account> &accounts);
-void deposit(std::vector<Checking_Account> &accounts, double amount);
-void withdraw(std::vector<Checking_Account> &accounts, double amount);
+void deposit(std::vector<Checking_Account> &accounts, Money amount);
+void withdraw(std::vector<Checking_Account> &accounts, Money amount);
 
 // Utility helper functions for Trust Account class
 void display(const std::vector<Trust_Account> &accounts);
-void deposit(std::vector<Trust_Account> &accounts, double amount);
-void withdraw(std::vector<Trust_Account> &accounts, double amount);
+void deposit(std::vector<Trust_Account> &accounts, Money amount);
+void withdraw(std::vector<Trust_Account> &accounts, Money amount);
+
+// Utility helper functions for Account_Ledger
+// (batch deposit/withdraw are Account_Ledger members and print nothing)
+void display(const Account_Ledger &ledger);
+void display(const Success_Bitmap &results, const char *operation);
 
 #endif
\ No newline at end of file
@@ -1,10 +1,10 @@
 #include "Checking_Account.h"
 
-Checking_Account::Checking_Account(std::string name, double balance)
+Checking_Account::Checking_Account(std::string name, Money balance)
     : Account {name, balance} {
 }
 
-bool Checking_Account::withdraw(double amount) {
+bool Checking_Account::withdraw(Money amount) {
     amount += per_check_fee;
     return Account::withdraw(amount);
 }
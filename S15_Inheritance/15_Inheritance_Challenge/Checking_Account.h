@@ -8,11 +8,13 @@ class Checking_Account: public Account {
     friend std::ostream &operator<<(std::ostream &os, const Checking_Account &account);
 private:
     static constexpr const char *def_name = "Unnamed Checking Account";
-    static constexpr double def_balance = 0.0;
-    static constexpr double per_check_fee = 1.5;
+    static constexpr Money def_balance {};
 public:
-    Checking_Account(std::string name = def_name, double balance = def_balance);    
-    bool withdraw(double);
+    // The rule, also applied by Account_Ledger and Concurrent_Checking_Account
+    static constexpr Money per_check_fee = Money::from_cents(150);
+
+    Checking_Account(std::string name = def_name, Money balance = def_balance);    
+    bool withdraw(Money);
     // Inherits the Account::deposit method
 };
 
@@ -0,0 +1,121 @@
+#include <stdexcept>
+#include "Concurrent_Account.h"
+#include "Checking_Account.h"
+#include "Trust_Account.h"
+
+std::uint64_t Concurrent_Account::pack(Money balance, int withdrawals) {
+    const std::int64_t cents = balance.in_cents();
+    if (cents < -balance_offset || cents >= balance_offset)
+        throw std::overflow_error {"Concurrent_Account: balance out of range"};
+    return (static_cast<std::uint64_t>(withdrawals) << balance_bits)
+           | static_cast<std::uint64_t>(cents + balance_offset);
+}
+
+Concurrent_Account::Concurrent_Account(std::string name, Money balance)
+    : name{name}, state{pack(balance, 0)} {
+}
+
+// A single atomic add of the amount to the balance field. The add that
+// would carry out of the field (past the largest balance) is taken back
+// out and reported. Until then other threads see a smaller balance or a
+// higher withdrawal count, which can only make them refuse a withdrawal.
+bool Concurrent_Account::deposit(Money amount) {
+    if (amount < Money {})
+        return false;
+    if (amount.in_cents() > static_cast<std::int64_t>(balance_mask))
+        throw std::overflow_error {"Concurrent_Account: balance out of range"};
+    const std::uint64_t delta = static_cast<std::uint64_t>(amount.in_cents());
+    const std::uint64_t before = state.fetch_add(delta, std::memory_order_acq_rel);
+    if ((before & balance_mask) + delta > balance_mask) {
+        state.fetch_sub(delta, std::memory_order_acq_rel);
+        throw std::overflow_error {"Concurrent_Account: balance out of range"};
+    }
+    return true;
+}
+
+// Compare-and-swap loop: when another thread changes the account between
+// the read and the swap, the swap fails, current is reloaded and the rule
+// is checked again against the new balance.
+bool Concurrent_Account::withdraw(Money amount) {
+    std::uint64_t current = state.load(std::memory_order_relaxed);
+    std::uint64_t next;
+    do {
+        const Money balance = balance_of(current);
+        if (!(amount <= balance))
+            return false;
+        next = pack(balance - amount, withdrawals_of(current));
+    } while (!state.compare_exchange_weak(current, next, std::memory_order_acq_rel, std::memory_order_relaxed));
+    return true;
+}
+
+std::ostream &operator<<(std::ostream &os, const Concurrent_Account &account) {
+    os << "[Account: " << account.name << ": " << account.get_balance() << "]";
+    return os;
+}
+
+Concurrent_Savings_Account::Concurrent_Savings_Account(std::string name, Money balance, double int_rate)
+    : Concurrent_Account {name, balance}, int_rate{int_rate} {
+}
+
+// Interest depends only on the amount, so it is added before the one atomic add
+bool Concurrent_Savings_Account::deposit(Money amount) {
+    amount += amount.percent(int_rate);
+    return Concurrent_Account::deposit(amount);
+}
+
+std::ostream &operator<<(std::ostream &os, const Concurrent_Savings_Account &account) {
+    os << "[Savings_Account: " << account.name << ": " << account.get_balance() << ", " << account.int_rate << "]";
+    return os;
+}
+
+Concurrent_Checking_Account::Concurrent_Checking_Account(std::string name, Money balance)
+    : Concurrent_Account {name, balance} {
+}
+
+bool Concurrent_Checking_Account::withdraw(Money amount) {
+    amount += Checking_Account::per_check_fee;
+    return Concurrent_Account::withdraw(amount);
+}
+
+std::ostream &operator<<(std::ostream &os, const Concurrent_Checking_Account &account) {
+    os << "[Checking_Account: " << account.name << ": " << account.get_balance() << "]";
+    return os;
+}
+
+Concurrent_Trust_Account::Concurrent_Trust_Account(std::string name, Money balance, double int_rate)
+    : Concurrent_Savings_Account {name, balance, int_rate} {
+}
+
+bool Concurrent_Trust_Account::deposit(Money amount) {
+    if (amount >= Trust_Account::bonus_threshold)
+        amount += Trust_Account::bonus_amount;
+    return Concurrent_Savings_Account::deposit(amount);
+}
+
+// The withdrawal count and the balance live in the same word, so checking
+// the limit and the 20% cap, counting the withdrawal and taking the money
+// happen in one swap: a 4th withdrawal fails however many threads race.
+// As in Trust_Account, a withdrawal that passes the limit and the cap is
+// counted even when the balance check then fails.
+bool Concurrent_Trust_Account::withdraw(Money amount) {
+    std::uint64_t current = state.load(std::memory_order_relaxed);
+    std::uint64_t next;
+    bool ok;
+    do {
+        const Money balance = balance_of(current);
+        const int count = withdrawals_of(current);
+        if (count >= Trust_Account::max_withdrawals
+            || amount * 100 > balance * Trust_Account::max_withdraw_percent)
+            return false;
+        ok = amount <= balance;
+        next = pack(ok ? balance - amount : balance, count + 1);
+    } while (!state.compare_exchange_weak(current, next, std::memory_order_acq_rel, std::memory_order_relaxed));
+    return ok;
+}
+
+std::ostream &operator<<(std::ostream &os, const Concurrent_Trust_Account &account) {
+    const std::uint64_t snapshot = account.state.load(std::memory_order_acquire);
+    os << "[Trust Account: " << account.name << ": " << Concurrent_Trust_Account::balance_of(snapshot) << ", " << account.int_rate
+        << "%, withdrawals: " << Concurrent_Trust_Account::withdrawals_of(snapshot) << "]";
+    return os;
+}
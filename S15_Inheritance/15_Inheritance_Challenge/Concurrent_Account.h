@@ -0,0 +1,104 @@
+// Concurrent_Account: the Account hierarchy for shared use across threads
+//
+// Account::deposit / withdraw read and write balance with no
+// synchronization, so two threads working on the same account lose
+// updates. The concurrent classes keep the same rules (and share the
+// constants of Checking_Account and Trust_Account) but store the account
+// state in one atomic 64-bit word:
+//   bits 56..63 : withdrawals counted so far (Trust accounts only)
+//   bits  0..55 : balance in cents, offset by 2^55
+// so a Trust withdrawal can check and update the balance and the
+// withdrawal count in a single compare-and-swap.
+//
+//   deposit  : one lock-free atomic add (after the amount's own bonus or
+//              interest has been worked out)
+//   withdraw : a compare-and-swap loop; the rules are checked against the
+//              balance the swap replaces, so a withdrawal never succeeds
+//              on a balance another thread has already spent
+//
+// Balances are limited to +/- 2^55 cents (about $360 trillion);
+// going beyond that throws std::overflow_error and leaves the account
+// unchanged. The objects hold an atomic, so they cannot be copied or moved.
+#ifndef _CONCURRENT_ACCOUNT_H_
+#define _CONCURRENT_ACCOUNT_H_
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include "Money.h"
+
+class Concurrent_Account {
+    friend std::ostream &operator<<(std::ostream &os, const Concurrent_Account &account);
+private:
+    static constexpr const char *def_name = "Unnamed Account";
+    static constexpr Money def_balance {};
+protected:
+    static constexpr int balance_bits = 56;
+    static constexpr std::uint64_t balance_mask = (std::uint64_t {1} << balance_bits) - 1;
+    static constexpr std::int64_t balance_offset = std::int64_t {1} << (balance_bits - 1);
+
+    // State word <-> balance and withdrawal count (pack throws when the balance is out of range)
+    static std::uint64_t pack(Money balance, int withdrawals);
+    static Money balance_of(std::uint64_t state) {
+        return Money::from_cents(static_cast<std::int64_t>(state & balance_mask) - balance_offset);
+    }
+    static int withdrawals_of(std::uint64_t state) { return static_cast<int>(state >> balance_bits); }
+
+    std::string name;
+    std::atomic<std::uint64_t> state;
+public:
+    Concurrent_Account(std::string name = def_name, Money balance = def_balance);
+    Concurrent_Account(const Concurrent_Account &) = delete;
+    Concurrent_Account &operator=(const Concurrent_Account &) = delete;
+
+    bool deposit(Money amount);
+    bool withdraw(Money amount);
+
+    const std::string &get_name() const { return name; }
+    Money get_balance() const { return balance_of(state.load(std::memory_order_acquire)); }
+};
+
+class Concurrent_Savings_Account: public Concurrent_Account {
+    friend std::ostream &operator<<(std::ostream &os, const Concurrent_Savings_Account &account);
+private:
+    static constexpr const char *def_name = "Unnamed Savings Account";
+    static constexpr Money def_balance {};
+    static constexpr double def_int_rate = 0.0;
+protected:
+    const double int_rate;      // fixed, so threads read it without synchronization
+public:
+    Concurrent_Savings_Account(std::string name = def_name, Money balance = def_balance, double int_rate = def_int_rate);
+    bool deposit(Money amount);
+    // Inherits the Concurrent_Account::withdraw method
+};
+
+class Concurrent_Checking_Account: public Concurrent_Account {
+    friend std::ostream &operator<<(std::ostream &os, const Concurrent_Checking_Account &account);
+private:
+    static constexpr const char *def_name = "Unnamed Checking Account";
+    static constexpr Money def_balance {};
+public:
+    Concurrent_Checking_Account(std::string name = def_name, Money balance = def_balance);
+    bool withdraw(Money amount);
+    // Inherits the Concurrent_Account::deposit method
+};
+
+class Concurrent_Trust_Account: public Concurrent_Savings_Account {
+    friend std::ostream &operator<<(std::ostream &os, const Concurrent_Trust_Account &account);
+private:
+    static constexpr const char *def_name = "Unnamed Trust Account";
+    static constexpr Money def_balance {};
+    static constexpr double def_int_rate = 0.0;
+public:
+    Concurrent_Trust_Account(std::string name = def_name, Money balance = def_balance, double int_rate = def_int_rate);
+
+    // Deposits of $5000.00 or more will receive $50 bonus
+    bool deposit(Money amount);
+
+    // Only allowed maximum of 3 withdrawals, each can be up to a maximum of 20% of the account's value
+    bool withdraw(Money amount);
+
+    int get_num_withdrawals() const { return withdrawals_of(state.load(std::memory_order_acquire)); }
+};
+
+#endif // _CONCURRENT_ACCOUNT_H_
@@ -0,0 +1,26 @@
+#include <stdexcept>
+#include "Locked_Accounts.h"
+
+Locked_Accounts::Slot &Locked_Accounts::at(std::size_t id) {
+    if (id >= slots.size())
+        throw std::out_of_range {"Locked_Accounts: unknown account id"};
+    return slots[id];
+}
+
+const Locked_Accounts::Slot &Locked_Accounts::at(std::size_t id) const {
+    if (id >= slots.size())
+        throw std::out_of_range {"Locked_Accounts: unknown account id"};
+    return slots[id];
+}
+
+Money Locked_Accounts::balance(std::size_t id) const {
+    const Slot &slot = at(id);
+    std::lock_guard<std::mutex> guard {slot.lock};
+    return std::visit([](const Account &account) { return account.get_balance(); }, slot.account);
+}
+
+void Locked_Accounts::display(std::ostream &os, std::size_t id) const {
+    const Slot &slot = at(id);
+    std::lock_guard<std::mutex> guard {slot.lock};
+    std::visit([&os](const auto &account) { os << account; }, slot.account);
+}
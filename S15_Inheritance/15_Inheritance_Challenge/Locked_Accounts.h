@@ -0,0 +1,57 @@
+// Locked_Accounts: accounts of any class of the hierarchy, one mutex each
+//
+// The storage shared by the classes that hand accounts out to several
+// threads (Transfer_Engine, Journaled_Accounts). Each account lives in a
+// Slot next to its own lock; whoever changes it holds that lock, and
+// balance() / display() take it to read a consistent account.
+//
+//   Locked_Accounts accounts;
+//   auto id = accounts.add(Savings_Account {"Larry", 0, 3.0});
+//   Locked_Accounts::Slot &slot = accounts.at(id);
+//   std::lock_guard<std::mutex> guard {slot.lock};    // then visit slot.account
+//
+// Accounts must all be added before other threads start using them;
+// add() is not safe to call concurrently with anything else.
+#ifndef _LOCKED_ACCOUNTS_H_
+#define _LOCKED_ACCOUNTS_H_
+#include <cstddef>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <variant>
+#include "Money.h"
+#include "Account.h"
+#include "Savings_Account.h"
+#include "Checking_Account.h"
+#include "Trust_Account.h"
+
+class Locked_Accounts {
+public:
+    struct alignas(64) Slot {       // one cache line per lock
+        mutable std::mutex lock;
+        std::variant<Account, Savings_Account, Checking_Account, Trust_Account> account;
+        template <typename T>
+        explicit Slot(const T &account) : account{account} {}
+    };
+private:
+    std::deque<Slot> slots;         // a deque never moves its elements (mutexes cannot move)
+public:
+    // Returns the new account's id: 0, 1, 2... in the order of the calls
+    template <typename T>
+    std::size_t add(const T &account) {
+        slots.emplace_back(account);
+        return slots.size() - 1;
+    }
+
+    std::size_t size() const { return slots.size(); }
+    Slot &operator[](std::size_t id) { return slots[id]; }
+    const Slot &operator[](std::size_t id) const { return slots[id]; }
+    Slot &at(std::size_t id);       // throws std::out_of_range for an unknown id
+    const Slot &at(std::size_t id) const;
+
+    // Take the account's lock; throw std::out_of_range for an unknown id
+    Money balance(std::size_t id) const;
+    void display(std::ostream &os, std::size_t id) const;   // as the account's own operator<<
+};
+
+#endif // _LOCKED_ACCOUNTS_H_
@@ -0,0 +1,46 @@
+#include <cmath>
+#include <iostream>
+#include "Money.h"
+
+namespace {
+
+// Round a cent value computed in double; values outside the int64 range
+// (or NaN) are out of range for Money
+std::int64_t round_cents(double cents) {
+    const double rounded = std::round(cents);
+    if (!(rounded >= -9223372036854775808.0 && rounded < 9223372036854775808.0))
+        throw std::overflow_error {"Money: amount out of range"};
+    return static_cast<std::int64_t>(rounded);
+}
+
+} // namespace
+
+Money::Money(double dollars)
+    : cents{round_cents(dollars * 100)} {
+}
+
+Money Money::percent(double rate) const {
+    return from_cents(round_cents(static_cast<double>(cents) * (rate / 100)));
+}
+
+// Prints dollars and exactly two decimals (e.g. -12.05), whatever the
+// stream's precision; the whole string honours the stream's width
+std::ostream &operator<<(std::ostream &os, const Money &money) {
+    const bool negative = money.cents < 0;
+    std::uint64_t magnitude = negative ? 0 - static_cast<std::uint64_t>(money.cents)
+                                       : static_cast<std::uint64_t>(money.cents);
+    char text[24];                      // "-92233720368547758.08" and the '\0'
+    char *p = text + sizeof text;
+    *--p = '\0';
+    *--p = static_cast<char>('0' + magnitude % 10);
+    *--p = static_cast<char>('0' + magnitude / 10 % 10);
+    *--p = '.';
+    magnitude /= 100;
+    do {
+        *--p = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (negative)
+        *--p = '-';
+    return os << p;
+}
@@ -0,0 +1,79 @@
+// Money: an exact amount of money as a 64-bit count of cents
+//
+// Balances used to be doubles, so fees, interest and bonuses picked up
+// rounding error and checks like balance - amount >= 0 could go either way
+// on values that print the same. Money adds and compares whole cents
+// exactly; only percent() (interest) rounds, once, to the nearest cent.
+//
+//   Money a {19.99};                 // from dollars, rounded to the cent
+//   Money fee = Money::from_cents(150);
+//   a += fee;                        // $21.49 exactly
+//
+// Arithmetic that would overflow the 64-bit range throws
+// std::overflow_error instead of wrapping around.
+#ifndef _MONEY_H_
+#define _MONEY_H_
+#include <cstdint>
+#include <iosfwd>
+#include <stdexcept>
+
+class Money {
+    friend std::ostream &operator<<(std::ostream &os, const Money &money);
+private:
+    std::int64_t cents;
+
+    struct Cents_tag {};
+    constexpr Money(std::int64_t cents, Cents_tag) : cents{cents} {}
+
+    static void check(bool overflow) {
+        if (overflow)
+            throw std::overflow_error {"Money: amount out of range"};
+    }
+public:
+    constexpr Money() : cents{0} {}
+    Money(double dollars);      // rounded to the nearest cent (implicit, so deposit(1000) still works)
+
+    static constexpr Money from_cents(std::int64_t cents) { return Money {cents, Cents_tag {}}; }
+    constexpr std::int64_t in_cents() const { return cents; }
+    double in_dollars() const { return static_cast<double>(cents) / 100; }
+
+    // rate percent of this amount, rounded half away from zero to the cent
+    Money percent(double rate) const;
+
+    Money operator-() const {
+        std::int64_t negated;
+        check(__builtin_sub_overflow(std::int64_t {0}, cents, &negated));
+        return from_cents(negated);
+    }
+    Money &operator+=(Money rhs) {
+        std::int64_t sum;
+        check(__builtin_add_overflow(cents, rhs.cents, &sum));
+        cents = sum;
+        return *this;
+    }
+    Money &operator-=(Money rhs) {
+        std::int64_t diff;
+        check(__builtin_sub_overflow(cents, rhs.cents, &diff));
+        cents = diff;
+        return *this;
+    }
+    Money &operator*=(std::int64_t n) {
+        std::int64_t product;
+        check(__builtin_mul_overflow(cents, n, &product));
+        cents = product;
+        return *this;
+    }
+
+    friend Money operator+(Money lhs, Money rhs) { return lhs += rhs; }
+    friend Money operator-(Money lhs, Money rhs) { return lhs -= rhs; }
+    friend Money operator*(Money lhs, std::int64_t n) { return lhs *= n; }
+
+    friend constexpr bool operator==(Money lhs, Money rhs) { return lhs.cents == rhs.cents; }
+    friend constexpr bool operator!=(Money lhs, Money rhs) { return lhs.cents != rhs.cents; }
+    friend constexpr bool operator<(Money lhs, Money rhs) { return lhs.cents < rhs.cents; }
+    friend constexpr bool operator<=(Money lhs, Money rhs) { return lhs.cents <= rhs.cents; }
+    friend constexpr bool operator>(Money lhs, Money rhs) { return lhs.cents > rhs.cents; }
+    friend constexpr bool operator>=(Money lhs, Money rhs) { return lhs.cents >= rhs.cents; }
+};
+
+#endif // _MONEY_H_
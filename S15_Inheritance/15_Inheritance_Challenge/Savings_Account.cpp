@@ -1,15 +1,15 @@
 #include "Savings_Account.h"
 
-Savings_Account::Savings_Account(std::string name, double balance, double int_rate)
+Savings_Account::Savings_Account(std::string name, Money balance, double int_rate)
     : Account {name, balance}, int_rate{int_rate} {
 }
 
 // Deposit:
-//      Amount supplied to deposit will be incremented by (amount * int_rate/100) 
-//      and then the updated amount will be deposited
+//      Amount supplied to deposit will be incremented by (amount * int_rate/100),
+//      rounded to the nearest cent, and then the updated amount will be deposited
 //
-bool Savings_Account::deposit(double amount) {
-    amount += amount * (int_rate/100);
+bool Savings_Account::deposit(Money amount) {
+    amount += amount.percent(int_rate);
     return Account::deposit(amount);
 }
 
@@ -6,14 +6,16 @@ class Savings_Account: public Account {
     friend std::ostream &operator<<(std::ostream &os, const Savings_Account &account);
 private:
     static constexpr const char *def_name = "Unnamed Savings Account";
-    static constexpr double def_balance = 0.0;
+    static constexpr Money def_balance {};
     static constexpr double def_int_rate = 0.0;
 protected:
     double int_rate;
 public:
-    Savings_Account(std::string name = def_name, double balance =def_balance, double int_rate = def_int_rate);    
-    bool deposit(double amount);
+    Savings_Account(std::string name = def_name, Money balance =def_balance, double int_rate = def_int_rate);    
+    bool deposit(Money amount);
     // Inherits the Account::withdraw method
+
+    double get_int_rate() const { return int_rate; }
 };
 
 #endif // _SAVINGS_ACCOUNT_H_
@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include "Transfer_Engine.h"
+
+Transfer_Engine::Transfer_Engine(unsigned worker_count)
+    : stopping{false} {
+    worker_count = std::max(worker_count, 1u);
+    for (unsigned i = 0; i < worker_count; ++i)
+        workers.emplace_back([this] { work(); });
+}
+
+Transfer_Engine::~Transfer_Engine() {
+    {
+        std::lock_guard<std::mutex> guard {queue_lock};
+        stopping = true;
+    }
+    queue_ready.notify_all();
+    for (auto &worker: workers)
+        worker.join();
+}
+
+Transfer_Engine::Account_id Transfer_Engine::add(const Account &account) { return accounts.add(account); }
+Transfer_Engine::Account_id Transfer_Engine::add(const Savings_Account &account) { return accounts.add(account); }
+Transfer_Engine::Account_id Transfer_Engine::add(const Checking_Account &account) { return accounts.add(account); }
+Transfer_Engine::Account_id Transfer_Engine::add(const Trust_Account &account) { return accounts.add(account); }
+
+Transfer_Engine::Snapshot Transfer_Engine::snapshot(const Slot &slot) {
+    return std::visit([](const auto &account) {
+        Snapshot saved {account.get_balance(), 0};
+        if constexpr (std::is_same_v<std::decay_t<decltype(account)>, Trust_Account>)
+            saved.num_withdrawals = account.get_num_withdrawals();
+        return saved;
+    }, slot.account);
+}
+
+void Transfer_Engine::restore(Slot &slot, const Snapshot &saved) {
+    std::visit([&saved](auto &account) {
+        account.adjust_balance(saved.balance - account.get_balance());
+        if constexpr (std::is_same_v<std::decay_t<decltype(account)>, Trust_Account>)
+            account.set_num_withdrawals(saved.num_withdrawals);
+    }, slot.account);
+}
+
+// Both locks are held. std::visit calls the withdraw of the source's own
+// class, so it keeps its rules. The destination is credited exactly the
+// amount, not through its deposit: Savings interest and the Trust bonus
+// would create money that no account paid.
+bool Transfer_Engine::transfer_locked(Slot &from, Slot &to, Money amount) {
+    const Snapshot saved = snapshot(from);
+    if (!std::visit([amount](auto &account) { return account.withdraw(amount); }, from.account)) {
+        restore(from, saved);       // a refused Trust withdrawal may still have been counted
+        return false;
+    }
+    try {
+        std::visit([amount](Account &account) { account.adjust_balance(amount); }, to.account);
+    } catch (...) {
+        restore(from, saved);
+        throw;
+    }
+    return true;
+}
+
+bool Transfer_Engine::transfer(Account_id from, Account_id to, Money amount) {
+    if (from >= accounts.size() || to >= accounts.size())
+        throw std::out_of_range {"Transfer_Engine: unknown account id"};
+    if (from == to || !(amount > Money {}))
+        return false;
+    Slot &source = accounts[from];
+    Slot &destination = accounts[to];
+    // Lower id first: every thread takes any two locks in the same order
+    std::lock_guard<std::mutex> first {(from < to ? source : destination).lock};
+    std::lock_guard<std::mutex> second {(from < to ? destination : source).lock};
+    return transfer_locked(source, destination, amount);
+}
+
+void Transfer_Engine::work() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> guard {queue_lock};
+            queue_ready.wait(guard, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty())
+                return;             // stopping, and every submitted chunk has run
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+std::future<Success_Bitmap> Transfer_Engine::submit(std::vector<Transfer> batch) {
+    for (const Transfer &t: batch)
+        if (t.from >= accounts.size() || t.to >= accounts.size())
+            throw std::out_of_range {"Transfer_Engine: unknown account id"};
+
+    struct Job {
+        std::vector<Transfer> batch;
+        Success_Bitmap result;
+        std::atomic<std::size_t> chunks_left;
+        std::promise<Success_Bitmap> done;
+    };
+    const std::size_t n = batch.size();
+    const std::size_t chunks = (n + chunk_size - 1) / chunk_size;
+    auto job = std::make_shared<Job>();
+    job->batch = std::move(batch);
+    job->result = Success_Bitmap {n};
+    job->chunks_left = chunks;
+    std::future<Success_Bitmap> done = job->done.get_future();
+    if (chunks == 0) {
+        job->done.set_value(std::move(job->result));
+        return done;
+    }
+    {
+        std::lock_guard<std::mutex> guard {queue_lock};
+        for (std::size_t begin = 0; begin < n; begin += chunk_size) {
+            tasks.emplace_back([this, job, begin] {
+                const std::size_t end = std::min(job->batch.size(), begin + chunk_size);
+                std::uint64_t word = 0;
+                for (std::size_t i = begin; i < end; ++i) {
+                    const Transfer &t = job->batch[i];
+                    bool ok;
+                    try {
+                        ok = transfer(t.from, t.to, t.amount);
+                    } catch (const std::overflow_error &) {
+                        ok = false;
+                    }
+                    word |= static_cast<std::uint64_t>(ok) << (i % 64);
+                    if (i % 64 == 63 || i + 1 == end) {
+                        job->result.set_word(i / 64, word);
+                        word = 0;
+                    }
+                }
+                // The last chunk to finish hands the whole bitmap over
+                if (job->chunks_left.fetch_sub(1) == 1)
+                    job->done.set_value(std::move(job->result));
+            });
+        }
+    }
+    queue_ready.notify_all();
+    return done;
+}
@@ -0,0 +1,103 @@
+// Transfer_Engine: moves money between accounts, safely across threads
+//
+// A withdraw on one account followed by a deposit on another is not a
+// transfer: another thread can act between the two calls, and a deposit
+// that fails leaves the money nowhere. The engine owns the accounts
+// (any class of the hierarchy, identified by the id add() returns) and
+// gives each one a mutex. transfer(from, to, amount):
+//   - locks the two accounts in increasing id order, so two transfers
+//     over the same pair in opposite directions can never deadlock
+//   - applies from's withdraw rules (Checking fee, Trust limits) and
+//     credits to with exactly the amount: a transfer moves money, so it
+//     earns no Savings interest or Trust bonus
+//   - commits both or neither: a refused withdrawal (even a counted Trust
+//     attempt) or a credit that would overflow leaves both accounts as
+//     they were
+//
+//   Transfer_Engine engine {4};                   // 4 worker threads
+//   auto a = engine.add(Checking_Account {"Moe", 2000});
+//   auto b = engine.add(Savings_Account {"Larry", 0, 3.0});
+//   engine.transfer(a, b, 100);                   // from any thread
+//   auto done = engine.submit(batch);             // run on the workers
+//   Success_Bitmap result = done.get();           // bit i: batch[i] succeeded
+//
+// Accounts must all be added before transfers start (see Locked_Accounts.h).
+#ifndef _TRANSFER_ENGINE_H_
+#define _TRANSFER_ENGINE_H_
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Money.h"
+#include "Account.h"
+#include "Savings_Account.h"
+#include "Checking_Account.h"
+#include "Trust_Account.h"
+#include "Account_Ledger.h"
+#include "Locked_Accounts.h"
+
+class Transfer_Engine {
+public:
+    using Account_id = std::size_t;
+
+    struct Transfer {
+        Account_id from;
+        Account_id to;
+        Money amount;
+    };
+private:
+    // Transfers of a batch handed to one worker at a time; a multiple of
+    // 64 so every chunk owns whole words of the Success_Bitmap
+    static constexpr std::size_t chunk_size = 4096;
+
+    using Slot = Locked_Accounts::Slot;
+    Locked_Accounts accounts;
+
+    std::mutex queue_lock;
+    std::condition_variable queue_ready;
+    std::deque<std::function<void()>> tasks;
+    bool stopping;
+    std::vector<std::thread> workers;
+
+    // What a failed transfer puts back on the source account
+    struct Snapshot {
+        Money balance;
+        int num_withdrawals;        // Trust_Account only
+    };
+    static Snapshot snapshot(const Slot &slot);
+    static void restore(Slot &slot, const Snapshot &saved);
+
+    bool transfer_locked(Slot &from, Slot &to, Money amount);
+    void work();
+public:
+    explicit Transfer_Engine(unsigned worker_count = std::thread::hardware_concurrency());
+    ~Transfer_Engine();             // finishes the submitted batches, then stops the workers
+    Transfer_Engine(const Transfer_Engine &) = delete;
+    Transfer_Engine &operator=(const Transfer_Engine &) = delete;
+
+    Account_id add(const Account &account);
+    Account_id add(const Savings_Account &account);
+    Account_id add(const Checking_Account &account);
+    Account_id add(const Trust_Account &account);
+
+    std::size_t size() const { return accounts.size(); }
+    Money balance(Account_id id) const { return accounts.balance(id); }
+    void display(std::ostream &os, Account_id id) const { accounts.display(os, id); }   // as the account's own operator<<
+
+    // Safe to call from any thread. Returns false (and changes nothing) when
+    // the withdraw rule refuses, the amount is not positive or from == to; throws
+    // std::out_of_range for an unknown id and std::overflow_error (changing
+    // nothing) when the destination balance would overflow.
+    bool transfer(Account_id from, Account_id to, Money amount);
+
+    // Runs the batch on the worker threads, in parallel and in no particular
+    // order. Transfers that would overflow count as failed.
+    std::future<Success_Bitmap> submit(std::vector<Transfer> batch);
+};
+
+#endif // _TRANSFER_ENGINE_H_
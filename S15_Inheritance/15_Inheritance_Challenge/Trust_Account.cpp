@@ -1,20 +1,21 @@
 #include "Trust_Account.h"
 
-Trust_Account::Trust_Account(std::string name, double balance, double int_rate)
+Trust_Account::Trust_Account(std::string name, Money balance, double int_rate)
     : Savings_Account {name, balance, int_rate}, num_withdrawals {0}  {
         
 }
 
 // Deposit additional $50 bonus when amount >= $5000
-bool Trust_Account::deposit(double amount) {
+bool Trust_Account::deposit(Money amount) {
     if (amount >= bonus_threshold)
         amount += bonus_amount;
     return Savings_Account::deposit(amount);
 }
     
 // Only allowed 3 withdrawals, each can be up to a maximum of 20% of the account's value
-bool Trust_Account::withdraw(double amount) {
-    if (num_withdrawals >= max_withdrawals || (amount > balance * max_withdraw_percent))
+// (amount * 100 > balance * 20 compares the exact cents, no rounding)
+bool Trust_Account::withdraw(Money amount) {
+    if (num_withdrawals >= max_withdrawals || (amount * 100 > balance * max_withdraw_percent))
         return false;
     else {
         ++num_withdrawals;
@@ -7,22 +7,28 @@ class Trust_Account : public Savings_Account {
     friend std::ostream &operator<<(std::ostream &os, const Trust_Account &account);
 private:
     static constexpr const char *def_name = "Unnamed Trust Account";
-    static constexpr double def_balance = 0.0;
+    static constexpr Money def_balance {};
     static constexpr double def_int_rate = 0.0;
-    static constexpr double bonus_amount = 50.0;
-    static constexpr double bonus_threshold = 5000.0;
+public:
+    // The rules, also applied by Account_Ledger and Concurrent_Trust_Account
+    static constexpr Money bonus_amount = Money::from_cents(5000);
+    static constexpr Money bonus_threshold = Money::from_cents(500000);
     static constexpr int max_withdrawals = 3;
-    static constexpr double max_withdraw_percent = 0.2;
+    static constexpr int max_withdraw_percent = 20;
 protected:
     int num_withdrawals;
 public:
-    Trust_Account(std::string name = def_name,  double balance = def_balance, double int_rate = def_int_rate);
+    Trust_Account(std::string name = def_name,  Money balance = def_balance, double int_rate = def_int_rate);
     
     // Deposits of $5000.00 or more will receive $50 bonus
-    bool deposit(double amount);
+    bool deposit(Money amount);
     
     // Only allowed maximum of 3 withdrawals, each can be up to a maximum of 20% of the account's value
-    bool withdraw(double amount);
+    bool withdraw(Money amount);
+
+    int get_num_withdrawals() const { return num_withdrawals; }
+    // Sets the count with no rule, like Account::adjust_balance
+    void set_num_withdrawals(int count) { num_withdrawals = count; }
 };
 
 #endif // _TRUST_ACCOUNT_H_
@@ -5,6 +5,7 @@
 #include "Checking_Account.h"
 #include "Trust_Account.h"
 #include "Account_Util.h"
+#include "Account_Ledger.h"
 
 using namespace std; 
 
@@ -63,6 +64,17 @@ int main() {
     // All withdrawals should fail if there are too many withdrawals or if the withdrawl is > 20% of the balance
     for (int i=1; i<=5; i++)
         withdraw(trust_accounts, 1000);
+
+    // Ledger: every account above in columns, updated in batches
+    Account_Ledger ledger;
+    ledger.add(accounts);
+    ledger.add(sav_accounts);
+    ledger.add(check_accounts);
+    ledger.add(trust_accounts);
+
+    display(ledger.deposit(1000), "Batch deposit of 1000");
+    display(ledger.withdraw(2000), "Batch withdrawal of 2000");
+    display(ledger);
     
 
     